@@ -0,0 +1,67 @@
+#include "ArrayTour.h"
+#include <stdexcept>
+#include <utility>
+
+ArrayTour::ArrayTour(const std::vector<int> &tour) : order(tour)
+{
+    if (order.size() > 1 && order.front() == order.back())
+        order.pop_back();
+
+    position.assign(order.size(), -1);
+    for (int p = 0; p < size(); ++p)
+    {
+        int vertex = order[p];
+        if (vertex < 0 || vertex >= size() || position[vertex] != -1)
+            throw std::invalid_argument("The tour must visit every vertex exactly once.");
+
+        position[vertex] = p;
+    }
+}
+
+void ArrayTour::twoOptMove(int a, int b, int c, int /* d */)
+{
+    // Reversing b..c in the direction a -> b, or c..b if the tour is currently walked the other way round.
+    if (next(a) == b)
+        reverse(b, c);
+    else
+        reverse(c, b);
+}
+
+void ArrayTour::reverse(int from, int to)
+{
+    int n = size();
+    int i = position[from];
+    int j = position[to];
+    int length = distanceAlong(from, to) + 1;
+
+    // The complement yields the same cycle, so the shorter of the two is reversed.
+    if (2 * length > n)
+    {
+        int complementBegin = j + 1 == n ? 0 : j + 1;
+        j = i == 0 ? n - 1 : i - 1;
+        i = complementBegin;
+        length = n - length;
+    }
+
+    for (int step = 0; step < length / 2; ++step)
+    {
+        std::swap(order[i], order[j]);
+        position[order[i]] = i;
+        position[order[j]] = j;
+        i = i + 1 == n ? 0 : i + 1;
+        j = j == 0 ? n - 1 : j - 1;
+    }
+}
+
+std::vector<int> ArrayTour::closedTour(int start) const
+{
+    std::vector<int> tour;
+    tour.reserve(order.size() + 1);
+    for (int step = 0, p = position[start]; step < size(); ++step)
+    {
+        tour.push_back(order[p]);
+        p = p + 1 == size() ? 0 : p + 1;
+    }
+    tour.push_back(start);
+    return tour;
+}
@@ -0,0 +1,57 @@
+#ifndef ARRAY_TOUR_H
+#define ARRAY_TOUR_H
+
+#include <vector>
+
+// ArrayTour stores a cyclic tour as an array of vertices together with the position of every vertex.
+// Neighbour queries are O(1) and a 2-opt move reverses the shorter of the two paths it splits the tour into,
+// which may leave the tour traversed in the opposite direction. Moves are therefore stated as edge exchanges.
+class ArrayTour
+{
+public:
+    // Accepts a closed tour (first vertex repeated at the end) as returned by the TSP heuristics, or an open one.
+    // The tour must visit every vertex in [0, n) exactly once.
+    explicit ArrayTour(const std::vector<int> &tour);
+
+    int size() const { return static_cast<int>(order.size()); }
+    int at(int position) const { return order[position]; }
+    int positionOf(int vertex) const { return position[vertex]; }
+
+    int next(int vertex) const
+    {
+        int p = position[vertex] + 1;
+        return order[p == size() ? 0 : p];
+    }
+
+    int prev(int vertex) const
+    {
+        int p = position[vertex];
+        return order[p == 0 ? size() - 1 : p - 1];
+    }
+
+    // Number of edges walked from a to b in the current direction.
+    int distanceAlong(int a, int b) const
+    {
+        int steps = position[b] - position[a];
+        return steps < 0 ? steps + size() : steps;
+    }
+
+    // True if b lies on the path from a to c walked in the current direction.
+    bool between(int a, int b, int c) const { return distanceAlong(a, b) <= distanceAlong(a, c); }
+
+    // Replaces edges (a, b) and (c, d) with (a, c) and (b, d). The tour must read a, b, ..., c, d in one of its
+    // two directions.
+    void twoOptMove(int a, int b, int c, int d);
+
+    // Closed tour starting and ending at the given vertex.
+    std::vector<int> closedTour(int start) const;
+
+private:
+    std::vector<int> order;
+    std::vector<int> position;
+
+    // Reverses the path from -> to walked in the current direction, or its complement when that is shorter.
+    void reverse(int from, int to);
+};
+
+#endif // ARRAY_TOUR_H
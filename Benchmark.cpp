@@ -0,0 +1,146 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+#include <stdexcept>
+
+// Value at fraction q of the sorted samples, interpolated between the two closest ranks.
+static double percentile(const std::vector<double> &sorted, double q)
+{
+    double rank = q * (sorted.size() - 1);
+    std::size_t lower = static_cast<std::size_t>(rank);
+    std::size_t upper = std::min(lower + 1, sorted.size() - 1);
+    return sorted[lower] + (rank - lower) * (sorted[upper] - sorted[lower]);
+}
+
+DurationSummary summarize(std::vector<double> samples)
+{
+    DurationSummary summary;
+    if (samples.empty())
+        return summary;
+
+    std::sort(samples.begin(), samples.end());
+    summary.min = samples.front();
+    summary.median = percentile(samples, 0.5);
+    summary.p90 = percentile(samples, 0.9);
+    summary.p99 = percentile(samples, 0.99);
+    summary.max = samples.back();
+    summary.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+    return summary;
+}
+
+void measure(BenchmarkRecord &record, int warmup, int repetitions, const std::function<BenchmarkSample(int)> &run)
+{
+    if (warmup < 0 || repetitions <= 0)
+        throw std::invalid_argument("Warmup must be non-negative and repetitions positive.");
+
+    for (int i = 0; i < warmup; ++i)
+        run(i);
+
+    std::vector<double> durations;
+    durations.reserve(repetitions);
+    double totalValue = 0;
+    for (int i = 0; i < repetitions; ++i)
+    {
+        BenchmarkSample sample = run(warmup + i);
+        durations.push_back(sample.seconds);
+        totalValue += sample.value;
+    }
+
+    record.warmup = warmup;
+    record.repetitions = repetitions;
+    record.duration = summarize(std::move(durations));
+    record.value = totalValue / repetitions;
+}
+
+void BenchmarkReport::add(const BenchmarkRecord &record)
+{
+    if (rows.empty())
+        out << std::left << std::setw(8) << "suite" << std::setw(18) << "algorithm" << std::setw(10) << "vertices" << std::setw(10) << "density"
+            << std::setw(8) << "threads" << std::setw(6) << "reps" << std::setw(13) << "median [s]" << std::setw(13) << "p90 [s]"
+            << std::setw(13) << "min [s]" << "value" << std::endl;
+
+    rows.push_back(record);
+    out << std::left << std::setw(8) << record.suite << std::setw(18) << record.algorithm << std::setw(10) << record.vertices
+        << std::setw(10) << record.density << std::setw(8) << record.threads << std::setw(6) << record.repetitions
+        << std::setw(13) << record.duration.median << std::setw(13) << record.duration.p90 << std::setw(13) << record.duration.min
+        << record.value << " (" << record.valueName << ")" << std::endl;
+}
+
+// Quotes a CSV field if it contains a separator, quote or line break.
+static std::string csvField(const std::string &text)
+{
+    if (text.find_first_of(",\"\n") == std::string::npos)
+        return text;
+
+    std::string quoted = "\"";
+    for (char c : text)
+    {
+        if (c == '"')
+            quoted += '"';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+static std::string jsonString(const std::string &text)
+{
+    std::string quoted = "\"";
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+            quoted += '\\';
+        if (c == '\n')
+            quoted += "\\n";
+        else
+            quoted += c;
+    }
+    return quoted + "\"";
+}
+
+void BenchmarkReport::writeCsv(const std::string &path) const
+{
+    std::ofstream file(path);
+    if (!file)
+        throw std::runtime_error("Could not open " + path + " for writing.");
+
+    file << std::setprecision(9);
+    file << "suite,algorithm,instance,vertices,density,threads,warmup,repetitions,min,median,p90,p99,max,mean,value_name,value\n";
+    for (const BenchmarkRecord &row : rows)
+    {
+        file << csvField(row.suite) << ',' << csvField(row.algorithm) << ',' << csvField(row.instance) << ',' << row.vertices << ','
+             << csvField(row.density) << ',' << row.threads << ',' << row.warmup << ',' << row.repetitions << ','
+             << row.duration.min << ',' << row.duration.median << ',' << row.duration.p90 << ',' << row.duration.p99 << ','
+             << row.duration.max << ',' << row.duration.mean << ',' << csvField(row.valueName) << ',' << row.value << '\n';
+    }
+
+    if (!file.flush())
+        throw std::runtime_error("Could not write " + path + ".");
+}
+
+void BenchmarkReport::writeJson(const std::string &path) const
+{
+    std::ofstream file(path);
+    if (!file)
+        throw std::runtime_error("Could not open " + path + " for writing.");
+
+    file << std::setprecision(9);
+    file << "[\n";
+    for (std::size_t i = 0; i < rows.size(); ++i)
+    {
+        const BenchmarkRecord &row = rows[i];
+        file << "  {\"suite\": " << jsonString(row.suite) << ", \"algorithm\": " << jsonString(row.algorithm)
+             << ", \"instance\": " << jsonString(row.instance) << ", \"vertices\": " << row.vertices
+             << ", \"density\": " << jsonString(row.density) << ", \"threads\": " << row.threads
+             << ", \"warmup\": " << row.warmup << ", \"repetitions\": " << row.repetitions
+             << ", \"seconds\": {\"min\": " << row.duration.min << ", \"median\": " << row.duration.median
+             << ", \"p90\": " << row.duration.p90 << ", \"p99\": " << row.duration.p99 << ", \"max\": " << row.duration.max
+             << ", \"mean\": " << row.duration.mean << "}, \"value_name\": " << jsonString(row.valueName)
+             << ", \"value\": " << row.value << "}" << (i + 1 < rows.size() ? "," : "") << "\n";
+    }
+    file << "]\n";
+
+    if (!file.flush())
+        throw std::runtime_error("Could not write " + path + ".");
+}
@@ -0,0 +1,69 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <ostream>
+
+// Order statistics of the durations measured over the repetitions of one benchmark case, in seconds.
+// Percentiles interpolate linearly between the closest ranks.
+struct DurationSummary
+{
+    double min = 0;
+    double median = 0;
+    double p90 = 0;
+    double p99 = 0;
+    double max = 0;
+    double mean = 0;
+};
+
+DurationSummary summarize(std::vector<double> samples);
+
+// One run of a benchmark case: the duration the algorithm reported and a quality value (path weight, tour length...)
+// that lets equal inputs be compared across algorithms.
+struct BenchmarkSample
+{
+    double seconds;
+    double value;
+};
+
+// One benchmark case with its parameters and results. The value is averaged over the measured repetitions.
+struct BenchmarkRecord
+{
+    std::string suite;
+    std::string algorithm;
+    std::string instance;
+    int vertices = 0;
+    std::string density;
+    int threads = 1;
+    int warmup = 0;
+    int repetitions = 0;
+    DurationSummary duration;
+    std::string valueName;
+    double value = 0;
+};
+
+// Calls run warmup times without recording, then repetitions times recording the samples, and fills the duration
+// summary and mean value of the record. run receives the index of the call, counting warmup calls first.
+void measure(BenchmarkRecord &record, int warmup, int repetitions, const std::function<BenchmarkSample(int)> &run);
+
+// BenchmarkReport collects records, prints each as a table row when it is added and writes all of them as CSV or JSON.
+class BenchmarkReport
+{
+public:
+    explicit BenchmarkReport(std::ostream &out) : out(out) {}
+
+    void add(const BenchmarkRecord &record);
+    const std::vector<BenchmarkRecord> &records() const { return rows; }
+
+    // Throw runtime_error if the file cannot be written.
+    void writeCsv(const std::string &path) const;
+    void writeJson(const std::string &path) const;
+
+private:
+    std::ostream &out;
+    std::vector<BenchmarkRecord> rows;
+};
+
+#endif // BENCHMARK_H
@@ -0,0 +1,470 @@
+#include "Benchmark.h"
+#include "Graph.h"
+#include "ContractionHierarchy.h"
+#include "CounterRng.h"
+#include "EuclideanGraph.h"
+#include "InstanceFiles.h"
+#include "TspHeuristics.h"
+#include "TourImprovement.h"
+#include "TspPortfolio.h"
+#include <iostream>
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <algorithm>
+
+static const char *Usage =
+    "Usage: graph_benchmark <suite> [options]\n"
+    "\n"
+    "Suites:\n"
+    "  sssp    single-source shortest paths on random graphs (minheap, fibheap, bucket, deltastepping)\n"
+    "  p2p     point-to-point shortest paths on random graphs (dijkstra, bidirectional, ch)\n"
+    "  mst     minimum spanning forests on random graphs (prim, boruvka, filterkruskal)\n"
+    "  tsp     TSP heuristics on random cities (doubletree, christofides, hilbert, nearestneighbor,\n"
+    "          randominsertion, twoopt, orthreeopt, portfolio)\n"
+    "  dimacs  point-to-point shortest paths on a DIMACS graph (dijkstra, bidirectional, astar, ch)\n"
+    "  tsplib  TSP heuristics on a TSPLIB instance, reporting the gap to the optimal tour\n"
+    "\n"
+    "Options (lists are comma separated):\n"
+    "  --sizes N,...          vertex or city counts (default 1000,10000)\n"
+    "  --degrees KMin:KMax,.. degree bounds of the random graphs (default 0:10,0:50)\n"
+    "  --algorithms A,...     algorithms to run (default all of the suite)\n"
+    "  --threads T,...        thread counts of the parallel algorithms, 0 for all (default 0)\n"
+    "  --warmup N             unmeasured runs per case (default 1)\n"
+    "  --repetitions N        measured runs per case (default 5)\n"
+    "  --seed N               seed of the generated inputs and queries (default 1)\n"
+    "  --graph PATH           DIMACS .gr file (dimacs)\n"
+    "  --coordinates PATH     DIMACS .co file (dimacs, needed by astar)\n"
+    "  --instance PATH        TSPLIB .tsp file (tsplib)\n"
+    "  --tour PATH            TSPLIB optimal .tour file (tsplib)\n"
+    "  --csv PATH             also write the results as CSV\n"
+    "  --json PATH            also write the results as JSON\n";
+
+// Stream of the query endpoints, apart from the streams the generators use.
+static constexpr std::uint64_t QueryStream = 0x5eed;
+
+struct BenchmarkOptions
+{
+    std::string suite;
+    std::vector<int> sizes = {1000, 10000};
+    std::vector<std::pair<int, int>> degrees = {{0, 10}, {0, 50}};
+    std::vector<std::string> algorithms;
+    std::vector<int> threads = {0};
+    int warmup = 1;
+    int repetitions = 5;
+    unsigned seed = 1;
+    std::string graphPath;
+    std::string coordinatesPath;
+    std::string instancePath;
+    std::string tourPath;
+    std::string csvPath;
+    std::string jsonPath;
+};
+
+static std::vector<std::string> splitList(const std::string &text)
+{
+    std::vector<std::string> items;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ','))
+    {
+        if (!item.empty())
+            items.push_back(item);
+    }
+    return items;
+}
+
+static int parseInt(const std::string &text)
+{
+    std::size_t used = 0;
+    int value = std::stoi(text, &used);
+    if (used != text.size())
+        throw std::invalid_argument("Expected an integer, got " + text + ".");
+    return value;
+}
+
+static BenchmarkOptions parseOptions(int argc, char **argv)
+{
+    if (argc < 2)
+        throw std::invalid_argument("Missing the suite.");
+
+    BenchmarkOptions options;
+    options.suite = argv[1];
+    for (int i = 2; i < argc; ++i)
+    {
+        std::string name = argv[i];
+        if (i + 1 == argc)
+            throw std::invalid_argument("Missing the value of " + name + ".");
+        std::string value = argv[++i];
+
+        if (name == "--sizes")
+        {
+            options.sizes.clear();
+            for (const std::string &item : splitList(value))
+                options.sizes.push_back(parseInt(item));
+        }
+        else if (name == "--degrees")
+        {
+            options.degrees.clear();
+            for (const std::string &item : splitList(value))
+            {
+                std::size_t colon = item.find(':');
+                if (colon == std::string::npos)
+                    throw std::invalid_argument("Degree bounds must read KMin:KMax, got " + item + ".");
+                options.degrees.emplace_back(parseInt(item.substr(0, colon)), parseInt(item.substr(colon + 1)));
+            }
+        }
+        else if (name == "--algorithms")
+            options.algorithms = splitList(value);
+        else if (name == "--threads")
+        {
+            options.threads.clear();
+            for (const std::string &item : splitList(value))
+                options.threads.push_back(parseInt(item));
+        }
+        else if (name == "--warmup")
+            options.warmup = parseInt(value);
+        else if (name == "--repetitions")
+            options.repetitions = parseInt(value);
+        else if (name == "--seed")
+            options.seed = static_cast<unsigned>(std::stoul(value));
+        else if (name == "--graph")
+            options.graphPath = value;
+        else if (name == "--coordinates")
+            options.coordinatesPath = value;
+        else if (name == "--instance")
+            options.instancePath = value;
+        else if (name == "--tour")
+            options.tourPath = value;
+        else if (name == "--csv")
+            options.csvPath = value;
+        else if (name == "--json")
+            options.jsonPath = value;
+        else
+            throw std::invalid_argument("Unknown option " + name + ".");
+    }
+
+    if (options.sizes.empty() || options.degrees.empty() || options.threads.empty())
+        throw std::invalid_argument("Sweep lists must not be empty.");
+    return options;
+}
+
+// Algorithms of the suite that were asked for, in the order given; all of them if none were.
+static std::vector<std::string> selectAlgorithms(const BenchmarkOptions &options, const std::vector<std::string> &available)
+{
+    if (options.algorithms.empty())
+        return available;
+
+    for (const std::string &algorithm : options.algorithms)
+    {
+        if (std::find(available.begin(), available.end(), algorithm) == available.end())
+            throw std::invalid_argument("Unknown algorithm " + algorithm + " for suite " + options.suite + ".");
+    }
+    return options.algorithms;
+}
+
+// Thread count a non-positive request resolves to, as in ThreadPool.
+static int resolvedThreads(int threads)
+{
+    return threads > 0 ? threads : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+// Record of one case before it is measured.
+static BenchmarkRecord makeRecord(const std::string &suite, const std::string &algorithm, const std::string &instance, int vertices,
+                                  const std::string &density, int threads, const std::string &valueName)
+{
+    BenchmarkRecord record;
+    record.suite = suite;
+    record.algorithm = algorithm;
+    record.instance = instance;
+    record.vertices = vertices;
+    record.density = density;
+    record.threads = threads;
+    record.valueName = valueName;
+    return record;
+}
+
+static std::string degreesName(const std::pair<int, int> &degrees)
+{
+    return std::to_string(degrees.first) + ":" + std::to_string(degrees.second);
+}
+
+// Sum of the reachable distances, which equal searches reproduce whatever engine ran them.
+static double distanceChecksum(const ShortestPathTree &tree)
+{
+    double sum = 0;
+    for (int distance : tree.distances)
+    {
+        if (distance != ShortestPathTree::Unreachable)
+            sum += distance;
+    }
+    return sum;
+}
+
+static void runSingleSource(const BenchmarkOptions &options, BenchmarkReport &report)
+{
+    std::vector<std::string> algorithms = selectAlgorithms(options, {"minheap", "fibheap", "bucket", "deltastepping"});
+    for (int V : options.sizes)
+    {
+        for (const auto &degrees : options.degrees)
+        {
+            Graph graph = Graph::randomDegree(V, degrees.first, degrees.second, options.seed);
+            graph.freeze();
+            CounterRng sources(options.seed, QueryStream);
+
+            for (const std::string &algorithm : algorithms)
+            {
+                bool parallel = algorithm == "deltastepping";
+                for (int threads : parallel ? options.threads : std::vector<int>{1})
+                {
+                    BenchmarkRecord record = makeRecord("sssp", algorithm, "random", V, degreesName(degrees), resolvedThreads(threads), "distance sum");
+                    measure(record, options.warmup, options.repetitions, [&](int run)
+                            {
+                                int source = sources.uniformIntAt(run, 0, V - 1);
+                                std::pair<ShortestPathTree, double> result =
+                                    algorithm == "minheap" ? graph.dijkstraMinHeap(source)
+                                    : algorithm == "fibheap" ? graph.dijkstraFibHeap(source)
+                                    : algorithm == "bucket" ? graph.dijkstraBucket(source)
+                                                            : graph.deltaStepping(source, 0, threads);
+                                return BenchmarkSample{result.second, distanceChecksum(result.first)}; });
+                    report.add(record);
+                }
+            }
+        }
+    }
+}
+
+// Point-to-point queries between endpoints drawn from the seed; unreachable targets count as weight 0.
+static void runPointToPoint(const BenchmarkOptions &options, BenchmarkReport &report, const Graph &graph, const std::string &suite,
+                            const std::string &instance, const std::string &density, const std::vector<std::string> &algorithms)
+{
+    int V = graph.verticesCount();
+    CounterRng endpoints(options.seed, QueryStream);
+    std::unique_ptr<ContractionHierarchy> hierarchy;
+
+    for (const std::string &algorithm : algorithms)
+    {
+        if (algorithm == "ch" && !hierarchy)
+        {
+            hierarchy = std::make_unique<ContractionHierarchy>(graph);
+            BenchmarkRecord record = makeRecord(suite, "ch-preprocessing", instance, V, density, 1, "shortcuts");
+            measure(record, 0, 1, [&](int)
+                    { return BenchmarkSample{hierarchy->preprocessingDuration(), static_cast<double>(hierarchy->shortcutsCount())}; });
+            report.add(record);
+        }
+
+        BenchmarkRecord record = makeRecord(suite, algorithm, instance, V, density, 1, "path weight");
+        measure(record, options.warmup, options.repetitions, [&](int run)
+                {
+                    int source = endpoints.uniformIntAt(2 * static_cast<std::uint64_t>(run), 0, V - 1);
+                    int target = endpoints.uniformIntAt(2 * static_cast<std::uint64_t>(run) + 1, 0, V - 1);
+                    if (algorithm == "dijkstra")
+                    {
+                        auto result = graph.dijkstraMinHeap(source, target);
+                        return BenchmarkSample{result.second, result.first.isReachable(target) ? static_cast<double>(result.first.distances[target]) : 0};
+                    }
+
+                    auto result = algorithm == "ch"              ? hierarchy->shortestPath(source, target)
+                                  : algorithm == "bidirectional" ? graph.shortestPath(source, target, PathSearch::Bidirectional)
+                                                                 : graph.shortestPath(source, target, PathSearch::AStar);
+                    return BenchmarkSample{result.second, result.first.first.empty() ? 0 : static_cast<double>(result.first.second)}; });
+        report.add(record);
+    }
+}
+
+static void runRandomPointToPoint(const BenchmarkOptions &options, BenchmarkReport &report)
+{
+    std::vector<std::string> algorithms = selectAlgorithms(options, {"dijkstra", "bidirectional", "ch"});
+    for (int V : options.sizes)
+    {
+        for (const auto &degrees : options.degrees)
+        {
+            Graph graph = Graph::randomDegree(V, degrees.first, degrees.second, options.seed);
+            graph.freeze();
+            runPointToPoint(options, report, graph, "p2p", "random", degreesName(degrees), algorithms);
+        }
+    }
+}
+
+static void runDimacs(const BenchmarkOptions &options, BenchmarkReport &report)
+{
+    if (options.graphPath.empty())
+        throw std::invalid_argument("The dimacs suite needs --graph.");
+
+    std::vector<std::string> algorithms = selectAlgorithms(options, {"dijkstra", "bidirectional", "astar", "ch"});
+    bool needsCoordinates = std::find(algorithms.begin(), algorithms.end(), "astar") != algorithms.end();
+    if (needsCoordinates && options.coordinatesPath.empty())
+        throw std::invalid_argument("A* needs --coordinates.");
+
+    ThreadPool pool;
+    auto start_time = std::chrono::high_resolution_clock::now();
+    CsrGraph csr = loadDimacsGraph(options.graphPath, pool);
+    std::vector<City> coordinates;
+    if (!options.coordinatesPath.empty())
+        coordinates = loadDimacsCoordinates(options.coordinatesPath);
+    std::chrono::duration<double> durationLoad = std::chrono::high_resolution_clock::now() - start_time;
+
+    Graph graph(std::move(csr), std::move(coordinates));
+    BenchmarkRecord load = makeRecord("dimacs", "load", options.graphPath, graph.verticesCount(), "", pool.size(), "arcs");
+    measure(load, 0, 1, [&](int)
+            { return BenchmarkSample{durationLoad.count(), static_cast<double>(graph.freeze().arcsCount())}; });
+    report.add(load);
+
+    runPointToPoint(options, report, graph, "dimacs", options.graphPath, "", algorithms);
+}
+
+static void runMst(const BenchmarkOptions &options, BenchmarkReport &report)
+{
+    std::vector<std::string> algorithms = selectAlgorithms(options, {"prim", "boruvka", "filterkruskal"});
+    for (int V : options.sizes)
+    {
+        for (const auto &degrees : options.degrees)
+        {
+            Graph graph = Graph::randomDegree(V, degrees.first, degrees.second, options.seed);
+            graph.freeze();
+
+            for (const std::string &algorithm : algorithms)
+            {
+                MstAlgorithm engine = algorithm == "prim"      ? MstAlgorithm::Prim
+                                      : algorithm == "boruvka" ? MstAlgorithm::Boruvka
+                                                               : MstAlgorithm::FilterKruskal;
+                for (int threads : engine == MstAlgorithm::Prim ? std::vector<int>{1} : options.threads)
+                {
+                    BenchmarkRecord record = makeRecord("mst", algorithm, "random", V, degreesName(degrees), resolvedThreads(threads), "forest weight");
+                    measure(record, options.warmup, options.repetitions, [&](int)
+                            {
+                                auto result = graph.mst(engine, threads);
+                                return BenchmarkSample{result.second, static_cast<double>(result.first.totalWeight)}; });
+                    report.add(record);
+                }
+            }
+        }
+    }
+}
+
+// Runs the TSP heuristics from starts drawn from the seed. length measures a closed tour; the tsplib suite passes the
+// instance metric, so its values differ from the weights the heuristics optimize.
+static void runTspHeuristics(const BenchmarkOptions &options, BenchmarkReport &report, const EuclideanGraph &graph,
+                             const std::string &suite, const std::string &instance, const std::string &valueName,
+                             const std::function<double(const std::vector<int> &)> &length)
+{
+    std::vector<std::string> algorithms = selectAlgorithms(options, {"doubletree", "christofides", "hilbert", "nearestneighbor",
+                                                                     "randominsertion", "twoopt", "orthreeopt", "portfolio"});
+    int V = graph.verticesCount();
+    CounterRng starts(options.seed, QueryStream);
+    std::vector<int> candidates;
+
+    for (const std::string &algorithm : algorithms)
+    {
+        bool parallel = algorithm == "randominsertion" || algorithm == "portfolio";
+        if ((algorithm == "twoopt" || algorithm == "orthreeopt" || algorithm == "portfolio") && candidates.empty())
+            candidates = candidateLists(graph, 8);
+
+        for (int threads : parallel ? options.threads : std::vector<int>{1})
+        {
+            ThreadPool pool(parallel ? threads : 1);
+            BenchmarkRecord record = makeRecord(suite, algorithm, instance, V, "", pool.size(), valueName);
+            measure(record, options.warmup, options.repetitions, [&](int run)
+                    {
+                        int start = starts.uniformIntAt(run, 0, V - 1);
+                        std::pair<std::pair<std::vector<int>, int>, double> result;
+                        if (algorithm == "doubletree")
+                            result = doubleTreeTSP(graph, start);
+                        else if (algorithm == "christofides")
+                            result = christofidesTSP(graph, start);
+                        else if (algorithm == "hilbert")
+                            result = hilbertCurveTSP(graph, start);
+                        else if (algorithm == "nearestneighbor")
+                            result = nearestNeighborTSP(graph, start);
+                        else if (algorithm == "randominsertion")
+                            result = randomInsertionTSP(graph, start, (start + 1) % V, pool);
+                        else if (algorithm == "twoopt")
+                            result = twoOptTSP(graph, nearestNeighborTSP(graph, start).first.first, candidates);
+                        else if (algorithm == "orthreeopt")
+                            result = orThreeOptTSP(graph, doubleTreeTSP(graph, start).first.first, candidates);
+                        else
+                            result = portfolioTSP(graph, 2 * pool.size(), {TspHeuristic::NearestNeighbor, TspHeuristic::RandomInsertion}, pool, candidates, options.seed + run);
+                        return BenchmarkSample{result.second, length(result.first.first)}; });
+            report.add(record);
+        }
+    }
+}
+
+static void runRandomTsp(const BenchmarkOptions &options, BenchmarkReport &report)
+{
+    for (int V : options.sizes)
+    {
+        EuclideanGraph graph(City::generateRandomGraphCities(V, options.seed));
+        runTspHeuristics(options, report, graph, "tsp", "random", "tour length", [&](const std::vector<int> &tour)
+                         {
+                             double length = 0;
+                             for (std::size_t i = 0; i + 1 < tour.size(); ++i)
+                                 length += graph.weight(tour[i], tour[i + 1]);
+                             return length; });
+    }
+}
+
+static void runTsplib(const BenchmarkOptions &options, BenchmarkReport &report)
+{
+    if (options.instancePath.empty() || options.tourPath.empty())
+        throw std::invalid_argument("The tsplib suite needs --instance and --tour.");
+
+    TsplibInstance instance = loadTsplibInstance(options.instancePath);
+    std::vector<int> optimalTour = loadTsplibTour(options.tourPath);
+    // The heuristics run on scaled planar cities (see TsplibInstance::cities); tours are then measured by the instance metric.
+    EuclideanGraph graph(instance.cities);
+    runTspHeuristics(options, report, graph, "tsplib", instance.name, "gap [%]", [&](const std::vector<int> &tour)
+                     { return 100 * optimalityGap(instance, tour, optimalTour); });
+}
+
+int main(int argc, char **argv)
+{
+    BenchmarkOptions options;
+    try
+    {
+        options = parseOptions(argc, argv);
+    }
+    catch (const std::exception &error)
+    {
+        std::cerr << error.what() << "\n\n"
+                  << Usage;
+        return 2;
+    }
+
+    BenchmarkReport report(std::cout);
+    try
+    {
+        if (options.suite == "sssp")
+            runSingleSource(options, report);
+        else if (options.suite == "p2p")
+            runRandomPointToPoint(options, report);
+        else if (options.suite == "mst")
+            runMst(options, report);
+        else if (options.suite == "tsp")
+            runRandomTsp(options, report);
+        else if (options.suite == "dimacs")
+            runDimacs(options, report);
+        else if (options.suite == "tsplib")
+            runTsplib(options, report);
+        else
+        {
+            std::cerr << "Unknown suite " << options.suite << ".\n\n"
+                      << Usage;
+            return 2;
+        }
+
+        if (!options.csvPath.empty())
+            report.writeCsv(options.csvPath);
+        if (!options.jsonPath.empty())
+            report.writeJson(options.jsonPath);
+    }
+    catch (const std::exception &error)
+    {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
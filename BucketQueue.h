@@ -0,0 +1,60 @@
+#ifndef BUCKET_QUEUE_H
+#define BUCKET_QUEUE_H
+
+#include <vector>
+#include <utility>
+#include <stdexcept>
+
+// BucketQueue is Dial's circular bucket queue for monotone integer keys.
+// Every key pushed must lie in [lastExtracted, lastExtracted + maxSpread], which holds for Dijkstra
+// with non-negative edge weights not exceeding maxSpread. Stale entries are not removed on decrease,
+// callers skip them when they are extracted.
+class BucketQueue
+{
+private:
+    std::vector<std::vector<int>> buckets;
+    int cursor;
+    int current;
+    int count;
+
+public:
+    BucketQueue(int maxSpread) : buckets(maxSpread + 1), cursor(0), current(0), count(0)
+    {
+        if (maxSpread < 0)
+            throw std::invalid_argument("Bucket spread must be non-negative");
+    }
+
+    bool isEmpty() const { return count == 0; }
+    int size() const { return count; }
+
+    void push(int key, int id)
+    {
+        int spread = static_cast<int>(buckets.size());
+        if (key < current || key - current >= spread)
+            throw std::invalid_argument("Key is outside of the current bucket window");
+
+        buckets[key % spread].push_back(id);
+        ++count;
+    }
+
+    // Returns the identifier with the smallest key together with that key.
+    std::pair<int, int> extractMin()
+    {
+        if (count == 0)
+            throw std::out_of_range("Queue is empty");
+
+        int spread = static_cast<int>(buckets.size());
+        while (buckets[cursor].empty())
+        {
+            cursor = (cursor + 1) % spread;
+            ++current;
+        }
+
+        int id = buckets[cursor].back();
+        buckets[cursor].pop_back();
+        --count;
+        return std::make_pair(current, id);
+    }
+};
+
+#endif // BUCKET_QUEUE_H
@@ -0,0 +1,353 @@
+#include "ContractionHierarchy.h"
+#include "ShortestPathTree.h"
+#include <algorithm>
+#include <chrono>
+
+// Edge of the contraction graph. Shortcuts remember the contracted vertex they bridge, original edges use -1.
+struct ContractionEdge
+{
+    int target;
+    int weight;
+    int middle;
+};
+
+// Shortcut u - w through the vertex being contracted.
+struct ShortcutCandidate
+{
+    int from;
+    int to;
+    int weight;
+};
+
+// Contractor holds the shrinking overlay graph used while the hierarchy is built.
+class Contractor
+{
+public:
+    std::vector<std::vector<ContractionEdge>> edges;
+    std::vector<bool> contracted;
+    std::vector<int> deletedNeighbors;
+
+    Contractor(const CsrGraph &graph, int settleLimit)
+        : edges(graph.verticesCount()), contracted(graph.verticesCount(), false), deletedNeighbors(graph.verticesCount(), 0),
+          settleLimit(settleLimit), witnessDistances(graph.verticesCount(), ShortestPathTree::Unreachable), isTarget(graph.verticesCount(), false),
+          witnessHeap(graph.verticesCount())
+    {
+        for (int u = 0; u < graph.verticesCount(); ++u)
+        {
+            for (const Arc &arc : graph.neighbors(u))
+            {
+                if (arc.dest != u)
+                    edges[u].push_back({arc.dest, arc.weight, -1});
+            }
+        }
+    }
+
+    // Shortcuts that contracting the vertex would require, collected into the buffer.
+    void findShortcuts(int vertex, std::vector<ShortcutCandidate> &shortcuts)
+    {
+        shortcuts.clear();
+        neighbors.clear();
+        for (const auto &edge : edges[vertex])
+        {
+            if (!contracted[edge.target])
+                neighbors.push_back(edge);
+        }
+
+        for (std::size_t i = 0; i + 1 < neighbors.size(); ++i)
+        {
+            int maxTarget = 0;
+            for (std::size_t j = i + 1; j < neighbors.size(); ++j)
+                maxTarget = std::max(maxTarget, neighbors[i].weight + neighbors[j].weight);
+
+            witnessSearch(neighbors[i].target, vertex, maxTarget, static_cast<int>(neighbors.size() - i - 1));
+            for (std::size_t j = i + 1; j < neighbors.size(); ++j)
+            {
+                int viaVertex = neighbors[i].weight + neighbors[j].weight;
+                if (witnessDistances[neighbors[j].target] > viaVertex)
+                    shortcuts.push_back({neighbors[i].target, neighbors[j].target, viaVertex});
+            }
+            resetWitnessSearch();
+        }
+    }
+
+    // Edge difference plus the number of already contracted neighbours, which spreads contraction uniformly.
+    int priority(int vertex, std::vector<ShortcutCandidate> &shortcuts)
+    {
+        findShortcuts(vertex, shortcuts);
+        return static_cast<int>(shortcuts.size()) - static_cast<int>(neighbors.size()) + deletedNeighbors[vertex];
+    }
+
+    void addShortcut(int from, int to, int weight, int middle)
+    {
+        addOrImprove(from, {to, weight, middle});
+        addOrImprove(to, {from, weight, middle});
+    }
+
+private:
+    int settleLimit;
+    std::vector<ContractionEdge> neighbors;
+    std::vector<int> witnessDistances;
+    std::vector<int> witnessTouched;
+    std::vector<bool> isTarget;
+    IndexedMinHeap<int> witnessHeap;
+
+    // Dijkstra from source that avoids the excluded vertex and all contracted ones. It stops once the last
+    // targetsCount neighbours are settled, beyond maxDistance or after settleLimit vertices; a search cut short
+    // only causes superfluous shortcuts.
+    void witnessSearch(int source, int excluded, int maxDistance, int targetsCount)
+    {
+        for (std::size_t j = neighbors.size() - targetsCount; j < neighbors.size(); ++j)
+            isTarget[neighbors[j].target] = true;
+
+        witnessDistances[source] = 0;
+        witnessTouched.push_back(source);
+        witnessHeap.insert(source, 0);
+
+        int settled = 0;
+        while (!witnessHeap.isEmpty() && settled < settleLimit)
+        {
+            auto entry = witnessHeap.extractMin();
+            if (entry.first > maxDistance)
+                break;
+
+            ++settled;
+            if (isTarget[entry.second] && --targetsCount == 0)
+                break;
+
+            for (const auto &edge : edges[entry.second])
+            {
+                if (edge.target == excluded || contracted[edge.target])
+                    continue;
+
+                int newDist = entry.first + edge.weight;
+                if (newDist < witnessDistances[edge.target])
+                {
+                    if (witnessDistances[edge.target] == ShortestPathTree::Unreachable)
+                        witnessTouched.push_back(edge.target);
+                    witnessDistances[edge.target] = newDist;
+                    witnessHeap.insertOrDecrease(edge.target, newDist);
+                }
+            }
+        }
+    }
+
+    void resetWitnessSearch()
+    {
+        for (const auto &neighbor : neighbors)
+            isTarget[neighbor.target] = false;
+        for (int v : witnessTouched)
+            witnessDistances[v] = ShortestPathTree::Unreachable;
+        witnessTouched.clear();
+        witnessHeap.clear();
+    }
+
+    void addOrImprove(int vertex, const ContractionEdge &edge)
+    {
+        for (auto &existing : edges[vertex])
+        {
+            if (existing.target != edge.target)
+                continue;
+
+            if (edge.weight < existing.weight)
+                existing = edge;
+            return;
+        }
+        edges[vertex].push_back(edge);
+    }
+};
+
+ContractionHierarchy::ContractionHierarchy(const Graph &graph, int witnessSettleLimit)
+    : V(graph.verticesCount()), rank(graph.verticesCount(), -1)
+{
+    const CsrGraph &source = graph.freeze();
+    if (source.arcsCount() > 0 && source.minWeight() < 0)
+        throw std::invalid_argument("Contraction hierarchies require non-negative edge weights.");
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    Contractor contractor(source, witnessSettleLimit);
+    std::vector<ShortcutCandidate> candidates;
+
+    IndexedMinHeap<int> order(V);
+    for (int v = 0; v < V; ++v)
+        order.insert(v, contractor.priority(v, candidates));
+
+    int nextRank = 0;
+    while (!order.isEmpty())
+    {
+        int v = order.extractMin().second;
+
+        // Lazy update: a vertex whose priority grew since it was queued goes back unless it is still the minimum.
+        int priority = contractor.priority(v, candidates);
+        if (!order.isEmpty() && priority > order.minimum().first)
+        {
+            order.insert(v, priority);
+            continue;
+        }
+
+        for (const auto &shortcut : candidates)
+            contractor.addShortcut(shortcut.from, shortcut.to, shortcut.weight, v);
+        shortcuts += candidates.size();
+
+        contractor.contracted[v] = true;
+        rank[v] = nextRank++;
+        for (const auto &edge : contractor.edges[v])
+        {
+            if (!contractor.contracted[edge.target])
+                ++contractor.deletedNeighbors[edge.target];
+        }
+    }
+
+    std::vector<std::int64_t> offsets(V + 1, 0);
+    std::vector<ContractionEdge> row;
+    std::vector<int> targets;
+    std::vector<int> weights;
+    for (int v = 0; v < V; ++v)
+    {
+        row.clear();
+        for (const auto &edge : contractor.edges[v])
+        {
+            if (rank[edge.target] > rank[v])
+                row.push_back(edge);
+        }
+        std::sort(row.begin(), row.end(), [](const ContractionEdge &a, const ContractionEdge &b)
+                  { return a.target < b.target; });
+
+        for (const auto &edge : row)
+        {
+            targets.push_back(edge.target);
+            weights.push_back(edge.weight);
+            middles.push_back(edge.middle);
+        }
+        offsets[v + 1] = targets.size();
+    }
+    upward = CsrGraph(V, std::move(offsets), std::move(targets), std::move(weights));
+
+    for (int side = 0; side < 2; ++side)
+    {
+        distances[side].assign(V, ShortestPathTree::Unreachable);
+        parents[side].assign(V, -1);
+        heaps[side] = IndexedMinHeap<int>(V);
+    }
+
+    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start_time;
+    buildDuration = duration.count();
+}
+
+std::pair<int, int> ContractionHierarchy::search(int source, int target) const
+{
+    if (source < 0 || source >= V || target < 0 || target >= V)
+        throw std::invalid_argument("The vertices must be within the range of the graph.");
+
+    resetSearch();
+    distances[0][source] = 0;
+    distances[1][target] = 0;
+    touched.push_back(source);
+    touched.push_back(target);
+    heaps[0].insert(source, 0);
+    heaps[1].insert(target, 0);
+
+    // Unlike plain bidirectional Dijkstra, each upward search may only stop once its own minimum exceeds the best path.
+    int best = ShortestPathTree::Unreachable;
+    int meeting = -1;
+    while (!heaps[0].isEmpty() || !heaps[1].isEmpty())
+    {
+        for (int side = 0; side < 2; ++side)
+        {
+            if (heaps[side].isEmpty())
+                continue;
+            if (heaps[side].minimum().first >= best)
+            {
+                heaps[side].clear();
+                continue;
+            }
+
+            int u = heaps[side].extractMin().second;
+            if (distances[1 - side][u] != ShortestPathTree::Unreachable && distances[side][u] + distances[1 - side][u] < best)
+            {
+                best = distances[side][u] + distances[1 - side][u];
+                meeting = u;
+            }
+
+            for (const Arc &arc : upward.neighbors(u))
+            {
+                int newDist = distances[side][u] + arc.weight;
+                if (newDist < distances[side][arc.dest])
+                {
+                    touched.push_back(arc.dest);
+                    distances[side][arc.dest] = newDist;
+                    parents[side][arc.dest] = u;
+                    heaps[side].insertOrDecrease(arc.dest, newDist);
+                }
+            }
+        }
+    }
+
+    return std::make_pair(meeting, best);
+}
+
+void ContractionHierarchy::resetSearch() const
+{
+    for (int v : touched)
+    {
+        for (int side = 0; side < 2; ++side)
+        {
+            distances[side][v] = ShortestPathTree::Unreachable;
+            parents[side][v] = -1;
+        }
+    }
+    touched.clear();
+    heaps[0].clear();
+    heaps[1].clear();
+}
+
+int ContractionHierarchy::distance(int source, int target) const
+{
+    return search(source, target).second;
+}
+
+std::pair<std::pair<std::vector<int>, int>, double> ContractionHierarchy::shortestPath(int source, int target) const
+{
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    auto result = search(source, target);
+    std::vector<int> path;
+    if (result.first != -1)
+    {
+        std::vector<int> upPath;
+        for (int current = result.first; current != -1; current = parents[0][current])
+            upPath.push_back(current);
+        std::reverse(upPath.begin(), upPath.end());
+        for (int current = parents[1][result.first]; current != -1; current = parents[1][current])
+            upPath.push_back(current);
+
+        path.push_back(upPath.front());
+        for (std::size_t i = 1; i < upPath.size(); ++i)
+            unpackEdge(upPath[i - 1], upPath[i], path);
+    }
+
+    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start_time;
+    return std::make_pair(std::make_pair(path, result.second), duration.count());
+}
+
+// Appends the original vertices after from up to and including to, expanding shortcuts recursively.
+void ContractionHierarchy::unpackEdge(int from, int to, std::vector<int> &path) const
+{
+    std::vector<std::pair<int, int>> stack = {{from, to}};
+    while (!stack.empty())
+    {
+        auto edge = stack.back();
+        stack.pop_back();
+
+        int lower = rank[edge.first] < rank[edge.second] ? edge.first : edge.second;
+        int higher = lower == edge.first ? edge.second : edge.first;
+        int middle = middles[upward.arcIndex(lower, higher)];
+        if (middle == -1)
+            path.push_back(edge.second);
+        else
+        {
+            stack.emplace_back(middle, edge.second);
+            stack.emplace_back(edge.first, middle);
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef CONTRACTION_HIERARCHY_H
+#define CONTRACTION_HIERARCHY_H
+
+#include <vector>
+#include <utility>
+#include "Graph.h"
+#include "CsrGraph.h"
+#include "IndexedMinHeap.h"
+
+// ContractionHierarchy answers repeated shortest path queries on a graph that does not change.
+// Preprocessing contracts vertices one by one in order of importance and adds shortcut edges that preserve
+// distances between the remaining vertices. Queries then only relax edges leading to more important vertices.
+// The graph is undirected, so a single upward CSR serves both the forward and the backward search.
+class ContractionHierarchy
+{
+public:
+    // Vertices settled by one witness search before a shortcut is added without proof that it is needed.
+    static constexpr int DefaultWitnessSettleLimit = 500;
+
+    explicit ContractionHierarchy(const Graph &graph, int witnessSettleLimit = DefaultWitnessSettleLimit);
+
+    int verticesCount() const { return V; }
+    int rankOf(int vertex) const { return rank[vertex]; }
+    std::int64_t shortcutsCount() const { return shortcuts; }
+    double preprocessingDuration() const { return buildDuration; }
+
+    // Shortest path weight, or ShortestPathTree::Unreachable. Reuses internal buffers, so queries on the same
+    // instance must not run concurrently.
+    int distance(int sourceKey, int targetKey) const;
+    // Shortest path with every shortcut unpacked into original edges, its weight and the query duration.
+    std::pair<std::pair<std::vector<int>, int>, double> shortestPath(int sourceKey, int targetKey) const;
+
+private:
+    int V;
+    std::vector<int> rank;
+    // Upward arcs: from each vertex to its more important neighbours.
+    CsrGraph upward;
+    // Contracted vertex bridged by the upward arc at the same index, or -1 for an original edge.
+    std::vector<int> middles;
+    std::int64_t shortcuts = 0;
+    double buildDuration = 0;
+
+    // Query state, reset through the touched list so a query costs only the explored part of the hierarchy.
+    mutable std::vector<int> distances[2];
+    mutable std::vector<int> parents[2];
+    mutable std::vector<int> touched;
+    mutable IndexedMinHeap<int> heaps[2];
+
+    // Runs both upward searches and returns the meeting vertex and path weight.
+    std::pair<int, int> search(int source, int target) const;
+    void resetSearch() const;
+    void unpackEdge(int from, int to, std::vector<int> &path) const;
+};
+
+#endif // CONTRACTION_HIERARCHY_H
@@ -0,0 +1,52 @@
+#ifndef COUNTER_RNG_H
+#define COUNTER_RNG_H
+
+#include <cstdint>
+#include <limits>
+
+// CounterRng is a counter-based random number generator: the n-th number of stream s under seed k is a fixed hash of
+// (k, s, n), so any thread can produce any part of any stream without sharing state. Generators give every vertex or
+// work item its own stream, which keeps their output identical for any number of threads.
+// Satisfies UniformRandomBitGenerator, but uniformInt should be preferred over std::uniform_int_distribution,
+// whose results differ between standard libraries.
+class CounterRng
+{
+public:
+    using result_type = std::uint64_t;
+
+    CounterRng(std::uint64_t seed, std::uint64_t stream) : key(mix(seed) ^ mix(stream + 0x632be59bd9b4e019ull)) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    // Element index of the stream, without advancing it.
+    result_type at(std::uint64_t index) const { return mix(key + index * 0x9e3779b97f4a7c15ull); }
+    result_type operator()() { return at(counter++); }
+
+    // Integer in [low, high] by multiply-shift of the upper 32 bits; the bias is below (high - low + 1) / 2^32.
+    int uniformInt(int low, int high) { return scale(operator()(), low, high); }
+    int uniformIntAt(std::uint64_t index, int low, int high) const { return scale(at(index), low, high); }
+
+    // Real number in [0, 1).
+    double uniformReal() { return (operator()() >> 11) * 0x1.0p-53; }
+
+private:
+    std::uint64_t key;
+    std::uint64_t counter = 0;
+
+    // SplitMix64 finalizer, a bijection with full avalanche.
+    static std::uint64_t mix(std::uint64_t z)
+    {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    static int scale(std::uint64_t bits, int low, int high)
+    {
+        std::uint64_t range = static_cast<std::uint64_t>(static_cast<std::int64_t>(high) - low) + 1;
+        return static_cast<int>(low + static_cast<std::int64_t>(((bits >> 32) * range) >> 32));
+    }
+};
+
+#endif // COUNTER_RNG_H
@@ -0,0 +1,82 @@
+#include "CsrGraph.h"
+
+CsrGraph::CsrGraph(int V, std::vector<std::int64_t> offsets, std::vector<int> targets, std::vector<int> weights)
+    : V(V), ownedOffsets(std::move(offsets)), ownedTargets(std::move(targets)), ownedWeights(std::move(weights))
+{
+    if (V < 0)
+        throw std::invalid_argument("The number of vertices must be non-negative.");
+
+    if (ownedOffsets.size() != static_cast<std::size_t>(V) + 1 || ownedOffsets.front() != 0 ||
+        ownedTargets.size() != static_cast<std::size_t>(ownedOffsets.back()) || ownedWeights.size() != ownedTargets.size())
+        throw std::invalid_argument("Inconsistent CSR array sizes.");
+
+    if (!ownedWeights.empty())
+    {
+        auto bounds = std::minmax_element(ownedWeights.begin(), ownedWeights.end());
+        minEdgeWeight = *bounds.first;
+        maxEdgeWeight = *bounds.second;
+    }
+    bind();
+}
+
+CsrGraph::CsrGraph(int V, const std::int64_t *offsets, const int *targets, const int *weights, int minWeight, int maxWeight,
+                   std::shared_ptr<const void> keepAlive)
+    : V(V), maxEdgeWeight(maxWeight), minEdgeWeight(minWeight), keepAlive(std::move(keepAlive)), offsets(offsets), targets(targets), weights(weights)
+{
+    if (V < 0)
+        throw std::invalid_argument("The number of vertices must be non-negative.");
+    if (offsets == nullptr || offsets[0] != 0 || offsets[V] < 0 || (offsets[V] > 0 && (targets == nullptr || weights == nullptr)))
+        throw std::invalid_argument("Inconsistent CSR array sizes.");
+    if (this->keepAlive == nullptr)
+        throw std::invalid_argument("A CSR view needs an owner that keeps its memory alive.");
+}
+
+CsrGraph::CsrGraph(const CsrGraph &other)
+    : V(other.V), maxEdgeWeight(other.maxEdgeWeight), minEdgeWeight(other.minEdgeWeight), ownedOffsets(other.ownedOffsets),
+      ownedTargets(other.ownedTargets), ownedWeights(other.ownedWeights), keepAlive(other.keepAlive),
+      offsets(other.offsets), targets(other.targets), weights(other.weights)
+{
+    bind();
+}
+
+CsrGraph::CsrGraph(CsrGraph &&other) noexcept : CsrGraph()
+{
+    swap(*this, other);
+}
+
+CsrGraph &CsrGraph::operator=(CsrGraph other) noexcept
+{
+    swap(*this, other);
+    return *this;
+}
+
+// Swapping vectors keeps their buffers, so the array pointers stay valid in the objects they move to.
+void swap(CsrGraph &a, CsrGraph &b) noexcept
+{
+    using std::swap;
+    swap(a.V, b.V);
+    swap(a.maxEdgeWeight, b.maxEdgeWeight);
+    swap(a.minEdgeWeight, b.minEdgeWeight);
+    swap(a.ownedOffsets, b.ownedOffsets);
+    swap(a.ownedTargets, b.ownedTargets);
+    swap(a.ownedWeights, b.ownedWeights);
+    swap(a.keepAlive, b.keepAlive);
+    swap(a.offsets, b.offsets);
+    swap(a.targets, b.targets);
+    swap(a.weights, b.weights);
+}
+
+void CsrGraph::bind()
+{
+    if (keepAlive)
+        return;
+
+    offsets = ownedOffsets.data();
+    targets = ownedTargets.data();
+    weights = ownedWeights.data();
+}
+
+std::size_t CsrGraph::memoryUsage() const
+{
+    return ownedOffsets.capacity() * sizeof(std::int64_t) + ownedTargets.capacity() * sizeof(int) + ownedWeights.capacity() * sizeof(int);
+}
@@ -0,0 +1,138 @@
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+#include <memory>
+
+// Arc is one direction of an undirected edge, as seen from its source vertex.
+struct Arc
+{
+    int dest;
+    int weight;
+};
+
+// CsrGraph is a read-only compressed sparse row (CSR) snapshot of a graph.
+// Neighbours of vertex u occupy [offsets[u], offsets[u + 1]) of targets and weights, sorted by destination.
+// The arrays are either owned or a view into memory owned elsewhere (e.g. a mapped graph file), which the snapshot
+// keeps alive through a shared handle; copies of a view share that memory.
+class CsrGraph
+{
+public:
+    class NeighborIterator
+    {
+    private:
+        const int *target;
+        const int *weight;
+
+    public:
+        NeighborIterator(const int *target, const int *weight) : target(target), weight(weight) {}
+
+        Arc operator*() const { return {*target, *weight}; }
+
+        NeighborIterator &operator++()
+        {
+            ++target;
+            ++weight;
+            return *this;
+        }
+
+        bool operator!=(const NeighborIterator &other) const { return target != other.target; }
+        bool operator==(const NeighborIterator &other) const { return target == other.target; }
+    };
+
+    class NeighborRange
+    {
+    private:
+        const int *targets;
+        const int *weights;
+        int count;
+
+    public:
+        NeighborRange(const int *targets, const int *weights, int count) : targets(targets), weights(weights), count(count) {}
+
+        NeighborIterator begin() const { return NeighborIterator(targets, weights); }
+        NeighborIterator end() const { return NeighborIterator(targets + count, weights + count); }
+        int size() const { return count; }
+    };
+
+    CsrGraph() : V(0), ownedOffsets(1, 0) { bind(); }
+    // Takes ownership of prepared arrays. Every row of targets must already be sorted by destination.
+    CsrGraph(int V, std::vector<std::int64_t> offsets, std::vector<int> targets, std::vector<int> weights);
+    // Non-owning view over V + 1 offsets and offsets[V] targets and weights, valid while keepAlive is held.
+    // Rows must be sorted by destination; the weight bounds are taken as given, so no array is scanned.
+    CsrGraph(int V, const std::int64_t *offsets, const int *targets, const int *weights, int minWeight, int maxWeight,
+             std::shared_ptr<const void> keepAlive);
+
+    CsrGraph(const CsrGraph &other);
+    CsrGraph(CsrGraph &&other) noexcept;
+    CsrGraph &operator=(CsrGraph other) noexcept;
+    friend void swap(CsrGraph &a, CsrGraph &b) noexcept;
+
+    bool isView() const { return keepAlive != nullptr; }
+
+    int verticesCount() const { return V; }
+    std::int64_t arcsCount() const { return offsets[V]; }
+    int degree(int u) const { return static_cast<int>(offsets[u + 1] - offsets[u]); }
+    int maxWeight() const { return maxEdgeWeight; }
+    int minWeight() const { return minEdgeWeight; }
+    // Bytes of the owned arrays; a view owns none.
+    std::size_t memoryUsage() const;
+
+    // Raw arrays, e.g. for writing the snapshot to a file.
+    const std::int64_t *offsetsData() const { return offsets; }
+    const int *targetsData() const { return targets; }
+    const int *weightsData() const { return weights; }
+
+    NeighborRange neighbors(int u) const
+    {
+        return NeighborRange(targets + offsets[u], weights + offsets[u], degree(u));
+    }
+
+    bool hasEdge(int u, int v) const { return find(u, v) != nullptr; }
+
+    // Position of arc u -> v in the targets/weights arrays, or -1 when the vertices are not adjacent.
+    // Lets callers keep additional per-arc data in arrays aligned with the CSR layout.
+    std::int64_t arcIndex(int u, int v) const
+    {
+        const int *it = find(u, v);
+        return it == nullptr ? -1 : it - targets;
+    }
+
+    int weight(int u, int v) const
+    {
+        const int *it = find(u, v);
+        if (it == nullptr)
+            throw std::out_of_range("The vertices are not adjacent.");
+
+        return weights[it - targets];
+    }
+
+private:
+    int V;
+    int maxEdgeWeight = 0;
+    int minEdgeWeight = 0;
+    std::vector<std::int64_t> ownedOffsets;
+    std::vector<int> ownedTargets;
+    std::vector<int> ownedWeights;
+    std::shared_ptr<const void> keepAlive;
+    // The arrays in use: the owned vectors or the viewed memory.
+    const std::int64_t *offsets = nullptr;
+    const int *targets = nullptr;
+    const int *weights = nullptr;
+
+    // Points the arrays at the owned vectors unless this is a view.
+    void bind();
+
+    const int *find(int u, int v) const
+    {
+        const int *first = targets + offsets[u];
+        const int *last = targets + offsets[u + 1];
+        const int *it = std::lower_bound(first, last, v);
+        return (it != last && *it == v) ? it : nullptr;
+    }
+};
+
+#endif // CSR_GRAPH_H
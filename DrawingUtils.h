@@ -5,6 +5,8 @@
 #include <vector>
 #include <unordered_map>
 #include "Graph.h"
+
+#ifndef WITHOUT_CAIRO
 #include <cairo.h>
 
 void drawPathTSP(const std::unordered_map<int, City> &cities, const std::vector<int> &tspPath, std::string title)
@@ -61,5 +63,9 @@ void drawPathTSP(const std::unordered_map<int, City> &cities, const std::vector<
     cairo_destroy(cr);
     cairo_surface_destroy(surface);
 }
+#else
+// Builds without Cairo (WITHOUT_CAIRO defined) skip drawing.
+inline void drawPathTSP(const std::unordered_map<int, City> &, const std::vector<int> &, std::string) {}
+#endif
 
 #endif // DRAWING_UTILS_H
\ No newline at end of file
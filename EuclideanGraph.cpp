@@ -0,0 +1,20 @@
+#include "EuclideanGraph.h"
+
+EuclideanGraph::EuclideanGraph(const std::unordered_map<int, City> &cities) : xs(cities.size()), ys(cities.size())
+{
+    for (int i = 0; i < verticesCount(); ++i)
+    {
+        const City &city = cities.at(i);
+        xs[i] = city.x;
+        ys[i] = city.y;
+    }
+}
+
+EuclideanGraph::EuclideanGraph(const std::vector<City> &cities) : xs(cities.size()), ys(cities.size())
+{
+    for (int i = 0; i < verticesCount(); ++i)
+    {
+        xs[i] = cities[i].x;
+        ys[i] = cities[i].y;
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef EUCLIDEAN_GRAPH_H
+#define EUCLIDEAN_GRAPH_H
+
+#include <vector>
+#include <unordered_map>
+#include <cmath>
+#include <cstdint>
+#include "Graph.h"
+#include "CsrGraph.h"
+
+// EuclideanGraph is an implicit complete graph over city coordinates. Edge weights are computed on demand with the
+// same truncation as Graph(cities), so memory stays linear in the number of cities.
+// It offers the same traversal interface as CsrGraph (verticesCount, neighbors, hasEdge, weight).
+class EuclideanGraph
+{
+public:
+    class NeighborIterator
+    {
+    private:
+        const EuclideanGraph *graph;
+        int source;
+        int current;
+
+    public:
+        NeighborIterator(const EuclideanGraph *graph, int source, int current) : graph(graph), source(source), current(current) {}
+
+        Arc operator*() const { return {current, graph->weight(source, current)}; }
+
+        NeighborIterator &operator++()
+        {
+            ++current;
+            if (current == source)
+                ++current;
+            return *this;
+        }
+
+        bool operator!=(const NeighborIterator &other) const { return current != other.current; }
+        bool operator==(const NeighborIterator &other) const { return current == other.current; }
+    };
+
+    class NeighborRange
+    {
+    private:
+        const EuclideanGraph *graph;
+        int source;
+
+    public:
+        NeighborRange(const EuclideanGraph *graph, int source) : graph(graph), source(source) {}
+
+        NeighborIterator begin() const { return NeighborIterator(graph, source, source == 0 ? 1 : 0); }
+        NeighborIterator end() const { return NeighborIterator(graph, source, graph->verticesCount()); }
+        int size() const { return graph->verticesCount() - 1; }
+    };
+
+    EuclideanGraph(const std::unordered_map<int, City> &cities);
+    EuclideanGraph(const std::vector<City> &cities);
+
+    int verticesCount() const { return static_cast<int>(xs.size()); }
+    int x(int vertex) const { return xs[vertex]; }
+    int y(int vertex) const { return ys[vertex]; }
+    City city(int vertex) const { return City(vertex, xs[vertex], ys[vertex]); }
+    std::size_t memoryUsage() const { return (xs.capacity() + ys.capacity()) * sizeof(int); }
+
+    NeighborRange neighbors(int u) const { return NeighborRange(this, u); }
+    bool hasEdge(int u, int v) const { return u != v; }
+
+    int weight(int u, int v) const
+    {
+        std::int64_t dx = static_cast<std::int64_t>(xs[u]) - xs[v];
+        std::int64_t dy = static_cast<std::int64_t>(ys[u]) - ys[v];
+        return static_cast<int>(std::sqrt(static_cast<double>(dx * dx + dy * dy)));
+    }
+
+private:
+    std::vector<int> xs;
+    std::vector<int> ys;
+};
+
+#endif // EUCLIDEAN_GRAPH_H
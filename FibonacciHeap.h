@@ -2,6 +2,13 @@
 #define FIBONACCI_HEAP_H
 
 #include <iostream>
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <memory>
+#include <algorithm>
+#include <new>
+#include <type_traits>
 
 template <typename T>
 struct FibonacciHeapNode
@@ -19,24 +26,52 @@ public:
     FibonacciHeapNode(const T &key) : key(key), degree(0), isMarked(false),
                                       child(nullptr), left(this), right(this), parent(nullptr) {}
 
-    ~FibonacciHeapNode()
+    friend std::ostream &operator<<(std::ostream &os, const FibonacciHeapNode<T> &obj)
     {
-        if (child == nullptr)
-            return;
+        os << obj.key << " (" << obj.degree << ") " << (obj.isMarked ? "marked" : "");
+        return os;
+    }
+};
 
-        FibonacciHeapNode<T> *cur = child;
-        do
-        {
-            FibonacciHeapNode<T> *next = cur->right;
-            delete cur;
-            cur = next;
-        } while (cur != child);
+// FibonacciHeapArena is a monotonic node allocator: node storage is carved out of large blocks
+// and is only returned once the arena itself is destroyed.
+template <typename T>
+class FibonacciHeapArena
+{
+private:
+    std::allocator<FibonacciHeapNode<T>> allocator;
+    std::vector<std::pair<FibonacciHeapNode<T> *, std::size_t>> blocks;
+    FibonacciHeapNode<T> *cursor;
+    std::size_t remaining;
+    std::size_t blockSize;
+
+public:
+    FibonacciHeapArena(std::size_t blockSize = 4096) : cursor(nullptr), remaining(0), blockSize(blockSize) {}
+
+    FibonacciHeapArena(const FibonacciHeapArena &) = delete;
+    FibonacciHeapArena &operator=(const FibonacciHeapArena &) = delete;
+
+    ~FibonacciHeapArena()
+    {
+        for (const auto &block : blocks)
+            allocator.deallocate(block.first, block.second);
     }
 
-    friend std::ostream &operator<<(std::ostream &os, const FibonacciHeapNode<T> &obj)
+    // Returns uninitialized storage for count contiguous nodes.
+    FibonacciHeapNode<T> *allocate(std::size_t count)
     {
-        os << obj.key << " (" << obj.degree << ") " << (obj.isMarked ? "marked" : "");
-        return os;
+        if (count > remaining)
+        {
+            std::size_t size = std::max(count, blockSize);
+            blocks.emplace_back(allocator.allocate(size), size);
+            cursor = blocks.back().first;
+            remaining = size;
+        }
+
+        FibonacciHeapNode<T> *storage = cursor;
+        cursor += count;
+        remaining -= count;
+        return storage;
     }
 };
 
@@ -46,27 +81,27 @@ class FibonacciHeap
 private:
     FibonacciHeapNode<T> *minNode;
     int numNodes;
+    std::shared_ptr<FibonacciHeapArena<T>> arena;
+    // Arenas of heaps merged through union_ own some of this heap's nodes.
+    std::vector<std::shared_ptr<FibonacciHeapArena<T>>> adoptedArenas;
 
 public:
-    FibonacciHeap(FibonacciHeapNode<T> *minNode = nullptr, int numNodes = 0) : minNode(minNode), numNodes(numNodes) {}
+    FibonacciHeap(std::shared_ptr<FibonacciHeapArena<T>> arena = std::make_shared<FibonacciHeapArena<T>>())
+        : minNode(nullptr), numNodes(0), arena(std::move(arena)) {}
+
+    FibonacciHeap(const FibonacciHeap &) = delete;
+    FibonacciHeap &operator=(const FibonacciHeap &) = delete;
 
+    // Node memory is owned by the arena, only the keys need to be destroyed.
     ~FibonacciHeap()
     {
-        if (minNode == nullptr)
-            return;
-
-        FibonacciHeapNode<T> *cur = minNode;
-        do
-        {
-            FibonacciHeapNode<T> *next = cur->right;
-            delete cur;
-            cur = next;
-        } while (cur != minNode);
+        if (!std::is_trivially_destructible<T>::value && minNode != nullptr)
+            destroyDeep(minNode);
     }
 
     FibonacciHeapNode<T> *insert(const T &key)
     {
-        FibonacciHeapNode<T> *newNode = new FibonacciHeapNode<T>(key);
+        FibonacciHeapNode<T> *newNode = new (arena->allocate(1)) FibonacciHeapNode<T>(key);
         if (minNode == nullptr)
             minNode = newNode;
         else
@@ -79,6 +114,43 @@ public:
         return newNode;
     }
 
+    // Inserts every key with a single allocation and a single pass over the root list.
+    // The returned array holds the node of keys[i] at index i, so it can be used as a handle table.
+    FibonacciHeapNode<T> *insertAll(const std::vector<T> &keys)
+    {
+        if (keys.empty())
+            return nullptr;
+
+        int count = static_cast<int>(keys.size());
+        FibonacciHeapNode<T> *nodes = arena->allocate(count);
+        FibonacciHeapNode<T> *newMin = new (nodes) FibonacciHeapNode<T>(keys[0]);
+        for (int i = 1; i < count; ++i)
+        {
+            FibonacciHeapNode<T> *node = new (nodes + i) FibonacciHeapNode<T>(keys[i]);
+            node->left = node - 1;
+            node->left->right = node;
+            if (node->key < newMin->key)
+                newMin = node;
+        }
+        nodes[count - 1].right = nodes;
+        nodes[0].left = nodes + count - 1;
+
+        if (minNode == nullptr)
+            minNode = newMin;
+        else
+        {
+            FibonacciHeapNode<T> *lastNode = minNode->left;
+            minNode->left = nodes + count - 1;
+            nodes[count - 1].right = minNode;
+            nodes[0].left = lastNode;
+            lastNode->right = nodes;
+            if (newMin->key < minNode->key)
+                minNode = newMin;
+        }
+        numNodes += count;
+        return nodes;
+    }
+
     FibonacciHeapNode<T> *minimum() const { return minNode; }
 
     FibonacciHeap<T> *union_(FibonacciHeap<T> &other)
@@ -101,6 +173,9 @@ public:
         numNodes += other.numNodes;
         other.minNode = nullptr;
         other.numNodes = 0;
+        if (other.arena != arena)
+            adoptedArenas.push_back(other.arena);
+        adoptedArenas.insert(adoptedArenas.end(), other.adoptedArenas.begin(), other.adoptedArenas.end());
         return this;
     }
 
@@ -127,7 +202,7 @@ public:
 
         removeFromRootList(z);
         T key = z->key;
-        delete z;
+        z->~FibonacciHeapNode<T>();
 
         if (minNode != nullptr)
             consolidate();
@@ -169,6 +244,19 @@ public:
     }
 
 private:
+    void destroyDeep(FibonacciHeapNode<T> *first)
+    {
+        FibonacciHeapNode<T> *cur = first;
+        do
+        {
+            FibonacciHeapNode<T> *next = cur->right;
+            if (cur->child != nullptr)
+                destroyDeep(cur->child);
+            cur->~FibonacciHeapNode<T>();
+            cur = next;
+        } while (cur != first);
+    }
+
     void consolidate()
     {
         int maxDegree = static_cast<int>(log(numNodes) / log((1 + sqrt(5)) / 2)) + 1;
@@ -1,5 +1,13 @@
 #include "Graph.h"
-#include "MinHeap.h"
+#include "IndexedMinHeap.h"
+#include "BucketQueue.h"
+#include "RadixHeap.h"
+#include "ThreadPool.h"
+#include "TspHeuristics.h"
+#include "MinimumSpanningForest.h"
+#include "HilbertCurve.h"
+#include "GraphGenerators.h"
+#include "GraphFile.h"
 #include "FibonacciHeap.h"
 #include <iostream>
 #include <random>
@@ -7,78 +15,127 @@
 #include <unordered_set>
 #include <chrono>
 #include <stack>
+#include <limits>
+#include <atomic>
+#include <cstdint>
 
-std::random_device dev;
-std::mt19937 rng(dev());
+// Largest maximum edge weight for which dijkstraBucket uses Dial's buckets rather than a radix heap.
+const int MaxBucketQueueWeight = 1 << 16;
 
-Graph::Graph(int V) : V(V)
+// Dijkstra relaxation loop shared by the monotone integer queues. Stale queue entries are skipped on extraction.
+template <typename TQueue>
+static void dijkstraMonotone(const CsrGraph &graph, int target, TQueue &queue, ShortestPathTree &tree)
 {
-    if (V < 0)
-        throw std::invalid_argument("The number of vertices must be non-negative.");
+    queue.push(0, tree.source);
 
-    adj = new std::unordered_set<Edge, Edge::AdjListHash, Edge::AdjListEquals>[V];
+    while (!queue.isEmpty())
+    {
+        auto entry = queue.extractMin();
+        int u = entry.second;
+        if (tree.settled[u] || entry.first != tree.distances[u])
+            continue;
 
-    std::uniform_int_distribution<int> weight(1, 50);
+        tree.settled[u] = true;
+        if (u == target)
+            break;
 
-    for (int i = 0; i < V - 1; ++i)
-    {
-        for (int j = i + 1; j < V; ++j)
+        for (const Arc &edge : graph.neighbors(u))
         {
-            int edgeWeight = weight(rng);
-            addEdge({i, j, edgeWeight});
+            int newDist = tree.distances[u] + edge.weight;
+            if (!tree.settled[edge.dest] && newDist < tree.distances[edge.dest])
+            {
+                tree.distances[edge.dest] = newDist;
+                tree.parents[edge.dest] = u;
+                queue.push(newDist, edge.dest);
+            }
         }
     }
 }
 
+Graph::Graph(int V) : V(V)
+{
+    ThreadPool pool(0);
+    csr = std::make_unique<CsrGraph>(randomCompleteGraph(V, std::random_device{}(), pool));
+}
+
 Graph::Graph(int V, int KMin, int KMax) : V(V)
 {
-    if (V < 0)
-        throw std::invalid_argument("The number of vertices must be non-negative.");
+    ThreadPool pool(0);
+    csr = std::make_unique<CsrGraph>(randomDegreeGraph(V, KMin, KMax, std::random_device{}(), pool));
+}
 
-    adj = new std::unordered_set<Edge, Edge::AdjListHash, Edge::AdjListEquals>[V];
+Graph Graph::complete(int V, std::uint64_t seed, int threads)
+{
+    ThreadPool pool(threads);
+    return Graph(randomCompleteGraph(V, seed, pool));
+}
+
+Graph Graph::randomDegree(int V, int KMin, int KMax, std::uint64_t seed, int threads)
+{
+    ThreadPool pool(threads);
+    return Graph(randomDegreeGraph(V, KMin, KMax, seed, pool));
+}
+
+Graph::Graph(CsrGraph graph, std::vector<City> cities)
+    : V(graph.verticesCount()), csr(std::make_unique<CsrGraph>(std::move(graph))), cities(std::move(cities))
+{
+    if (!this->cities.empty() && static_cast<int>(this->cities.size()) != V)
+        throw std::invalid_argument("There must be one city per vertex.");
+}
 
-    if (KMin < 0 || KMax < KMin)
-        throw std::invalid_argument("Invalid edge constraints, all values must be non-negative and KMax >= KMin.");
+Graph::Graph(const std::string &path) : V(0)
+{
+    csr = std::make_unique<CsrGraph>(mapGraphFile(path, &cities));
+    V = csr->verticesCount();
+}
 
-    std::uniform_int_distribution<int> edges(KMin, KMax);
-    std::uniform_int_distribution<int> weight(1, 50);
-    std::uniform_int_distribution<int> randomVertex(0, V - 1);
+Graph::Graph(const std::unordered_map<int, City> &cities, bool spatialOrder) : V(cities.size())
+{
+    adj = new std::unordered_set<Edge, Edge::AdjListHash, Edge::AdjListEquals>[V];
 
-    std::vector<int> degrees(V, 0);
+    this->cities.reserve(V);
     for (int i = 0; i < V; ++i)
+        this->cities.push_back(cities.at(i));
+
+    if (spatialOrder)
     {
-        int edgesCount = edges(rng);
-        for (int iter = 0; degrees[i] < edgesCount && iter < 3 * V; ++iter)
+        originalIds = hilbertOrder(this->cities);
+        vertexIds.resize(V);
+        std::vector<City> ordered;
+        ordered.reserve(V);
+        for (int v = 0; v < V; ++v)
         {
-            int targetVertex = randomVertex(rng);
-            if (targetVertex != i && degrees[targetVertex] < KMax && !hasEdge({targetVertex, i}))
-            {
-                addEdge({targetVertex, i, weight(rng)});
-                degrees[i]++;
-                degrees[targetVertex]++;
-            }
+            vertexIds[originalIds[v]] = v;
+            ordered.push_back(this->cities[originalIds[v]]);
         }
-
-        if (degrees[i] < KMin)
-            throw std::runtime_error("Could not generate a graph with the specified number of edges.");
+        this->cities.swap(ordered);
     }
-}
-
-Graph::Graph(const std::unordered_map<int, City> &cities) : V(cities.size())
-{
-    adj = new std::unordered_set<Edge, Edge::AdjListHash, Edge::AdjListEquals>[V];
 
     for (int i = 0; i < V - 1; ++i)
     {
         for (int j = i + 1; j < V; ++j)
         {
-            double dist = cities.at(i).distance(cities.at(j));
+            double dist = this->cities[i].distance(this->cities[j]);
             int edgeWeight = static_cast<int>(dist);
             addEdge({i, j, edgeWeight});
         }
     }
 }
 
+std::vector<int> Graph::toOriginalIds(const std::vector<int> &path) const
+{
+    std::vector<int> ids;
+    ids.reserve(path.size());
+    for (int vertex : path)
+        ids.push_back(originalId(vertex));
+    return ids;
+}
+
+void Graph::save(const std::string &path) const
+{
+    writeGraphFile(path, freeze(), cities.empty() ? nullptr : &cities);
+}
+
 Graph::Graph(int V, const std::vector<Edge> &edges) : V(V)
 {
     if (V < 0)
@@ -95,9 +152,11 @@ bool Graph::addEdge(const Edge &edge)
     if (V <= edge.src || V <= edge.dest)
         throw std::invalid_argument("The vertices must be within the range of the graph.");
 
+    thaw();
     if (adj[edge.src].insert(edge).second)
     {
         adj[edge.dest].insert(Edge(edge.dest, edge.src, edge.weight));
+        csr.reset();
         return true;
     }
     return false;
@@ -108,9 +167,11 @@ bool Graph::removeEdge(const Edge &edge)
     if (V <= edge.src || V <= edge.dest)
         throw std::invalid_argument("The vertices must be within the range of the graph.");
 
+    thaw();
     if (adj[edge.src].erase(edge))
     {
         adj[edge.dest].erase(Edge(edge.dest, edge.src, edge.weight));
+        csr.reset();
         return true;
     }
     return false;
@@ -118,301 +179,598 @@ bool Graph::removeEdge(const Edge &edge)
 
 bool Graph::hasEdge(const Edge &edge) const
 {
+    if (!adj)
+        return csr->hasEdge(edge.src, edge.dest);
+
     return adj[edge.src].count(edge) != 0;
 }
 
-std::pair<std::unordered_map<int, VertexInfo>, double> Graph::dijkstraMinHeap(int source) const
+void Graph::thaw()
 {
-    auto start_time = std::chrono::high_resolution_clock::now();
+    if (adj)
+        return;
+
+    adj = new std::unordered_set<Edge, Edge::AdjListHash, Edge::AdjListEquals>[V];
+    for (int u = 0; u < V; ++u)
+    {
+        adj[u].reserve(csr->degree(u));
+        for (const Arc &arc : csr->neighbors(u))
+            adj[u].insert(Edge(u, arc.dest, arc.weight));
+    }
+}
+
+void Graph::checkVertex(int vertex) const
+{
+    if (vertex < 0 || vertex >= V)
+        throw std::out_of_range("The vertices must be within the range of the graph.");
+}
+
+void Graph::updateStraightLineScale() const
+{
+    if (cities.empty())
+        return;
+
+    straightLineScale = std::numeric_limits<double>::max();
+    for (int u = 0; u < V; ++u)
+    {
+        for (const Arc &edge : csr->neighbors(u))
+        {
+            double length = cities[u].distance(cities[edge.dest]);
+            if (length > 0)
+                straightLineScale = std::min(straightLineScale, std::max(0, edge.weight) / length);
+        }
+    }
+    // Guards the scaled estimate against rounding above an exact integer path weight.
+    if (straightLineScale == std::numeric_limits<double>::max())
+        straightLineScale = 0;
+    straightLineScale *= 1 - 1e-12;
+}
+
+const CsrGraph &Graph::freeze() const
+{
+    if (csr)
+        return *csr;
+
+    std::vector<std::int64_t> offsets(V + 1, 0);
+    for (int i = 0; i < V; ++i)
+        offsets[i + 1] = offsets[i] + adj[i].size();
 
-    auto maxValue = std::numeric_limits<int>::max() / 2;
-    std::unordered_map<int, VertexInfo> verticesData;
+    std::vector<std::pair<int, int>> row;
+    std::vector<int> targets(offsets[V]);
+    std::vector<int> weights(offsets[V]);
     for (int i = 0; i < V; ++i)
-        verticesData.emplace(i, VertexInfo(i, maxValue, -1));
-    verticesData.at(source).distance = 0;
+    {
+        row.clear();
+        for (const auto &edge : adj[i])
+            row.emplace_back(edge.dest, edge.weight);
+        std::sort(row.begin(), row.end());
+
+        std::int64_t pos = offsets[i];
+        for (const auto &entry : row)
+        {
+            targets[pos] = entry.first;
+            weights[pos] = entry.second;
+            ++pos;
+        }
+    }
+
+    csr = std::make_unique<CsrGraph>(V, std::move(offsets), std::move(targets), std::move(weights));
+
+    // Recomputed by the next default A* search.
+    straightLineScale = -1;
+
+    return *csr;
+}
+
+std::pair<ShortestPathTree, double> Graph::dijkstraMinHeap(int source, int target) const
+{
+    checkVertex(source);
+    if (target != -1)
+        checkVertex(target);
+
+    const CsrGraph &graph = freeze();
+    auto start_time = std::chrono::high_resolution_clock::now();
 
-    MinHeap<VertexInfo, VertexInfo::VertexHash, VertexInfo::VertexEquals> minHeap;
-    for (const auto &entry : verticesData)
-        minHeap.insert(entry.second);
+    ShortestPathTree tree(source, V);
+    IndexedMinHeap<int> minHeap(V);
+    minHeap.insert(source, 0);
 
     while (!minHeap.isEmpty())
     {
-        auto u = minHeap.extractMin();
-        verticesData.at(u.vertex).isRemoved = true;
-        for (const Edge &edge : adj[u.vertex])
-        {
-            if (verticesData.at(edge.dest).isRemoved)
-                continue;
+        int u = minHeap.extractMin().second;
+        tree.settled[u] = true;
+        if (u == target)
+            break;
 
-            int newDist = verticesData.at(u.vertex).distance + edge.weight;
-            if (newDist < verticesData.at(edge.dest).distance)
+        for (const Arc &edge : graph.neighbors(u))
+        {
+            int newDist = tree.distances[u] + edge.weight;
+            if (!tree.settled[edge.dest] && newDist < tree.distances[edge.dest])
             {
-                verticesData.at(edge.dest).distance = newDist;
-                verticesData.at(edge.dest).parent = u.vertex;
-                minHeap.decreaseKey(verticesData.at(edge.dest), verticesData.at(edge.dest));
+                tree.distances[edge.dest] = newDist;
+                tree.parents[edge.dest] = u;
+                minHeap.insertOrDecrease(edge.dest, newDist);
             }
         }
     }
 
     std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start_time;
-    return std::make_pair(verticesData, duration.count());
+    return std::make_pair(std::move(tree), duration.count());
 }
 
-std::pair<std::unordered_map<int, VertexInfo>, double> Graph::dijkstraFibHeap(int source) const
+std::pair<ShortestPathTree, double> Graph::dijkstraFibHeap(int source, int target) const
 {
-    auto start_time = std::chrono::high_resolution_clock::now();
+    checkVertex(source);
+    if (target != -1)
+        checkVertex(target);
 
-    auto maxValue = std::numeric_limits<int>::max() / 2;
-    std::unordered_map<int, VertexInfo> verticesData;
-    for (int i = 0; i < V; ++i)
-        verticesData.emplace(i, VertexInfo(i, maxValue, -1));
-    verticesData.at(source).distance = 0;
+    const CsrGraph &graph = freeze();
+    auto start_time = std::chrono::high_resolution_clock::now();
 
-    std::unordered_map<int, FibonacciHeapNode<VertexInfo> *> nodeReferences;
+    ShortestPathTree tree(source, V);
+    std::vector<VertexInfo> keys;
+    keys.reserve(V);
+    for (int v = 0; v < V; ++v)
+        keys.emplace_back(v, tree.distances[v], -1);
     FibonacciHeap<VertexInfo> fibHeap;
-    for (const auto &entry : verticesData)
-        nodeReferences.emplace(entry.first, fibHeap.insert(entry.second));
+    FibonacciHeapNode<VertexInfo> *nodes = fibHeap.insertAll(keys);
 
     while (!fibHeap.isEmpty())
     {
-        auto u = fibHeap.extractMin();
-        verticesData.at(u.vertex).isRemoved = true;
-        for (const Edge &edge : adj[u.vertex])
-        {
-            if (verticesData.at(edge.dest).isRemoved)
-                continue;
+        VertexInfo closest = fibHeap.extractMin();
+        if (closest.distance == ShortestPathTree::Unreachable)
+            break;
+
+        int u = closest.vertex;
+        tree.settled[u] = true;
+        if (u == target)
+            break;
 
-            int newDist = verticesData.at(u.vertex).distance + edge.weight;
-            if (newDist < verticesData.at(edge.dest).distance)
+        for (const Arc &edge : graph.neighbors(u))
+        {
+            int newDist = tree.distances[u] + edge.weight;
+            if (!tree.settled[edge.dest] && newDist < tree.distances[edge.dest])
             {
-                verticesData.at(edge.dest).distance = newDist;
-                verticesData.at(edge.dest).parent = u.vertex;
-                fibHeap.decreaseKey(nodeReferences.at(edge.dest), verticesData.at(edge.dest));
+                tree.distances[edge.dest] = newDist;
+                tree.parents[edge.dest] = u;
+                fibHeap.decreaseKey(nodes + edge.dest, VertexInfo(edge.dest, newDist, u));
             }
         }
     }
 
     std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start_time;
-    return std::make_pair(verticesData, duration.count());
+    return std::make_pair(std::move(tree), duration.count());
 }
 
-void Graph::printDijkstraResults(int source, const std::unordered_map<int, VertexInfo> &distances)
+std::pair<ShortestPathTree, double> Graph::dijkstraBucket(int source, int target) const
 {
-    for (const auto &entry : distances)
-    {
-        std::vector<int> path;
-        int current = entry.second.vertex;
-        while (current != -1)
-        {
-            path.push_back(current);
-            current = distances.at(current).parent;
-        }
-        std::cout << "Vertex: " << entry.second.vertex << ", distance: " << entry.second.distance << ", path: ";
-        if (path.back() != source)
-        {
-            std::cout << "No path exists" << std::endl;
-            continue;
-        }
+    checkVertex(source);
+    if (target != -1)
+        checkVertex(target);
 
-        for (int i = path.size() - 1; i >= 0; --i)
-        {
-            std::cout << path[i];
-            if (i > 0)
-                std::cout << " -> ";
-        }
-        std::cout << std::endl;
+    const CsrGraph &graph = freeze();
+    if (graph.arcsCount() > 0 && graph.minWeight() < 0)
+        throw std::invalid_argument("Dijkstra's algorithm requires non-negative edge weights.");
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    ShortestPathTree tree(source, V);
+    if (graph.maxWeight() <= MaxBucketQueueWeight)
+    {
+        BucketQueue queue(graph.maxWeight());
+        dijkstraMonotone(graph, target, queue, tree);
+    }
+    else
+    {
+        RadixHeap queue;
+        dijkstraMonotone(graph, target, queue, tree);
     }
+
+    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start_time;
+    return std::make_pair(std::move(tree), duration.count());
 }
 
-std::vector<VertexInfo> Graph::primMST(int start) const
+// Delta-stepping keeps a vertex's distance and parent in one atomic word, distance in the upper half,
+// so that an improvement of both is a single compare-and-swap.
+static std::uint64_t packDistance(int distance, int parent)
 {
-    std::vector<VertexInfo> mst;
+    return (static_cast<std::uint64_t>(distance) << 32) | static_cast<std::uint32_t>(parent);
+}
 
-    auto maxValue = std::numeric_limits<int>::max() / 2;
-    std::vector<VertexInfo> vertices;
-    for (int i = 0; i < V; ++i)
-        vertices.emplace_back(VertexInfo(i, (i == start ? 0 : maxValue), -1));
+static int unpackDistance(std::uint64_t packed) { return static_cast<int>(packed >> 32); }
 
-    MinHeap<VertexInfo, VertexInfo::VertexHash, VertexInfo::VertexEquals> minHeap(vertices);
-    while (!minHeap.isEmpty())
+static int unpackParent(std::uint64_t packed) { return static_cast<int>(static_cast<std::uint32_t>(packed)); }
+
+static bool relaxAtomic(std::atomic<std::uint64_t> &slot, int distance, int parent)
+{
+    std::uint64_t desired = packDistance(distance, parent);
+    std::uint64_t current = slot.load(std::memory_order_relaxed);
+    while (distance < unpackDistance(current))
     {
-        VertexInfo u = minHeap.extractMin();
-        vertices.at(u.vertex).isRemoved = true;
-        mst.push_back(u);
+        if (slot.compare_exchange_weak(current, desired, std::memory_order_relaxed))
+            return true;
+    }
+    return false;
+}
+
+std::pair<ShortestPathTree, double> Graph::deltaStepping(int source, int delta, int threads) const
+{
+    checkVertex(source);
+    const CsrGraph &graph = freeze();
+    if (graph.arcsCount() > 0 && graph.minWeight() < 0)
+        throw std::invalid_argument("Delta-stepping requires non-negative edge weights.");
 
-        for (const auto &edge : adj[u.vertex])
+    if (delta <= 0)
+        delta = std::max<std::int64_t>(1, graph.maxWeight() * static_cast<std::int64_t>(V) / std::max<std::int64_t>(1, graph.arcsCount()));
+
+    ThreadPool pool(threads);
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::atomic<std::uint64_t>> state(V);
+    for (auto &slot : state)
+        slot.store(packDistance(ShortestPathTree::Unreachable, -1), std::memory_order_relaxed);
+    state[source].store(packDistance(0, -1), std::memory_order_relaxed);
+
+    std::vector<std::vector<int>> buckets(1, std::vector<int>{source});
+    std::vector<std::vector<int>> improved(pool.size());
+    std::vector<int> frontier;
+    std::vector<int> bucketMembers;
+    std::vector<long long> frontierMark(V, -1);
+    std::vector<long long> memberMark(V, -1);
+    long long phase = 0;
+
+    // Relaxes either the light (weight <= delta) or the heavy edges of the given vertices on all workers.
+    auto relax = [&](const std::vector<int> &vertices, bool light)
+    {
+        pool.parallelFor(static_cast<int>(vertices.size()), 64, [&](int worker, int begin, int end)
+                         {
+            std::vector<int> &out = improved[worker];
+            for (int k = begin; k < end; ++k)
+            {
+                int u = vertices[k];
+                int distance = unpackDistance(state[u].load(std::memory_order_relaxed));
+                for (const Arc &edge : graph.neighbors(u))
+                {
+                    if ((edge.weight <= delta) == light && relaxAtomic(state[edge.dest], distance + edge.weight, u))
+                        out.push_back(edge.dest);
+                }
+            } });
+
+        for (auto &out : improved)
         {
-            if (vertices.at(edge.dest).isRemoved)
-                continue;
+            for (int v : out)
+            {
+                std::size_t bucket = unpackDistance(state[v].load(std::memory_order_relaxed)) / delta;
+                if (bucket >= buckets.size())
+                    buckets.resize(bucket + 1);
+                buckets[bucket].push_back(v);
+            }
+            out.clear();
+        }
+    };
 
-            int adjVertex = edge.dest;
-            if (edge.weight < vertices.at(adjVertex).distance)
+    for (std::size_t i = 0; i < buckets.size(); ++i)
+    {
+        bucketMembers.clear();
+        while (!buckets[i].empty())
+        {
+            frontier.clear();
+            for (int v : buckets[i])
             {
-                vertices.at(adjVertex).parent = u.vertex;
-                vertices.at(adjVertex).distance = edge.weight;
-                minHeap.decreaseKey(vertices.at(adjVertex), VertexInfo(adjVertex, edge.weight, u.vertex));
+                if (frontierMark[v] == phase || unpackDistance(state[v].load(std::memory_order_relaxed)) / delta != static_cast<int>(i))
+                    continue;
+
+                frontierMark[v] = phase;
+                frontier.push_back(v);
+                if (memberMark[v] != static_cast<long long>(i))
+                {
+                    memberMark[v] = i;
+                    bucketMembers.push_back(v);
+                }
             }
+            buckets[i].clear();
+            ++phase;
+
+            relax(frontier, true);
         }
+
+        relax(bucketMembers, false);
+        std::vector<int>().swap(buckets[i]);
+    }
+
+    ShortestPathTree tree(source, V);
+    for (int i = 0; i < V; ++i)
+    {
+        std::uint64_t packed = state[i].load(std::memory_order_relaxed);
+        tree.distances[i] = unpackDistance(packed);
+        tree.parents[i] = unpackParent(packed);
+        tree.settled[i] = tree.isReachable(i);
     }
 
-    return mst;
+    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start_time;
+    return std::make_pair(std::move(tree), duration.count());
 }
 
-std::vector<int> Graph::preorderWalk(const std::vector<VertexInfo> &mst) const
+// Walks parent links from the vertex back to the root of its search tree and returns the vertices root first.
+static std::vector<int> tracePath(const std::vector<int> &parents, int vertex)
 {
-    std::vector<int> preorder;
-    if (mst.empty())
-        return preorder;
+    std::vector<int> path;
+    for (int current = vertex; current != -1; current = parents[current])
+        path.push_back(current);
+    std::reverse(path.begin(), path.end());
+    return path;
+}
 
-    std::vector<std::vector<int>> tree(V);
-    for (const auto &info : mst)
-    {
-        if (info.parent == -1)
-            continue;
+std::pair<std::pair<std::vector<int>, int>, double> Graph::shortestPath(int source, int target, PathSearch search) const
+{
+    checkVertex(source);
+    checkVertex(target);
+
+    if (search == PathSearch::AStar)
+        return shortestPathAStar(source, target);
 
-        tree[info.parent].push_back(info.vertex);
+    if (search == PathSearch::Dijkstra)
+    {
+        auto result = dijkstraMinHeap(source, target);
+        const ShortestPathTree &tree = result.first;
+        return std::make_pair(std::make_pair(tree.path(target), tree.distances[target]), result.second);
     }
 
-    std::vector<bool> visited(V, false);
-    std::stack<int> stack;
+    const CsrGraph &graph = freeze();
+    auto start_time = std::chrono::high_resolution_clock::now();
 
-    stack.push(mst[0].vertex);
-    while (!stack.empty())
+    // Side 0 searches forward from the source and side 1 backward from the target.
+    // The graph is undirected, so both sides relax the same adjacency.
+    std::vector<int> distances[2] = {std::vector<int>(V, ShortestPathTree::Unreachable), std::vector<int>(V, ShortestPathTree::Unreachable)};
+    std::vector<int> parents[2] = {std::vector<int>(V, -1), std::vector<int>(V, -1)};
+    std::vector<bool> settled[2] = {std::vector<bool>(V, false), std::vector<bool>(V, false)};
+    IndexedMinHeap<int> heaps[2] = {IndexedMinHeap<int>(V), IndexedMinHeap<int>(V)};
+
+    distances[0][source] = 0;
+    distances[1][target] = 0;
+    heaps[0].insert(source, 0);
+    heaps[1].insert(target, 0);
+
+    // The best known path runs source ~> forwardEnd -> backwardStart ~> target.
+    int best = source == target ? 0 : ShortestPathTree::Unreachable;
+    int forwardEnd = source == target ? source : -1;
+    int backwardStart = -1;
+    while (!heaps[0].isEmpty() && !heaps[1].isEmpty())
     {
-        int current = stack.top();
-        stack.pop();
+        if (heaps[0].minimum().first + heaps[1].minimum().first >= best)
+            break;
+
+        int side = heaps[0].size() <= heaps[1].size() ? 0 : 1;
+        int u = heaps[side].extractMin().second;
+        settled[side][u] = true;
 
-        if (!visited[current])
+        for (const Arc &edge : graph.neighbors(u))
         {
-            visited[current] = true;
-            preorder.push_back(current);
+            int newDist = distances[side][u] + edge.weight;
+            if (!settled[side][edge.dest] && newDist < distances[side][edge.dest])
+            {
+                distances[side][edge.dest] = newDist;
+                parents[side][edge.dest] = u;
+                heaps[side].insertOrDecrease(edge.dest, newDist);
+            }
 
-            for (auto it = tree[current].rbegin(); it != tree[current].rend(); ++it)
+            int remaining = distances[1 - side][edge.dest];
+            if (remaining != ShortestPathTree::Unreachable && newDist + remaining < best)
             {
-                if (!visited[*it])
-                    stack.push(*it);
+                best = newDist + remaining;
+                forwardEnd = side == 0 ? u : edge.dest;
+                backwardStart = side == 0 ? edge.dest : u;
             }
         }
     }
 
-    return preorder;
+    std::vector<int> path;
+    if (forwardEnd != -1)
+    {
+        path = tracePath(parents[0], forwardEnd);
+        for (int current = backwardStart; current != -1; current = parents[1][current])
+            path.push_back(current);
+    }
+
+    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start_time;
+    return std::make_pair(std::make_pair(path, best), duration.count());
 }
 
-std::pair<std::pair<std::vector<int>, int>, double> Graph::nearestNeighborTSP(int start) const
+std::pair<std::pair<std::vector<int>, int>, double> Graph::shortestPathAStar(int source, int target, const CityHeuristic &heuristic) const
 {
+    checkVertex(source);
+    checkVertex(target);
+    if (cities.empty())
+        throw std::invalid_argument("A* search requires a graph built from cities.");
+
+    const CsrGraph &graph = freeze();
+    if (!heuristic && straightLineScale < 0)
+        updateStraightLineScale();
     auto start_time = std::chrono::high_resolution_clock::now();
 
-    std::vector<int> tour;
-    int totalWeight = 0;
-    std::vector<bool> visited(V, false);
-    int current = start;
-    tour.push_back(current);
-    visited[current] = true;
+    const City &goal = cities[target];
+    std::vector<int> estimates(V, -1);
+    auto estimate = [&](int vertex)
+    {
+        if (estimates[vertex] < 0)
+        {
+            int value = heuristic ? heuristic(cities[vertex], goal) : static_cast<int>(std::min<double>(ShortestPathTree::Unreachable, straightLineScale * cities[vertex].distance(goal)));
+            estimates[vertex] = std::max(0, value);
+        }
+        return estimates[vertex];
+    };
+
+    // Vertices are reopened whenever their distance improves, so inconsistent heuristics stay exact if admissible.
+    std::vector<int> distances(V, ShortestPathTree::Unreachable);
+    std::vector<int> parents(V, -1);
+    IndexedMinHeap<int> open(V);
+    distances[source] = 0;
+    open.insert(source, estimate(source));
 
-    for (int i = 1; i < V; ++i)
+    while (!open.isEmpty())
     {
-        int minWeight = std::numeric_limits<int>::max();
-        int nextEdge;
-        for (const auto &edge : adj[current])
+        int u = open.extractMin().second;
+        if (u == target)
+            break;
+
+        for (const Arc &edge : graph.neighbors(u))
         {
-            if (!visited[edge.dest] && edge.weight < minWeight)
+            int newDist = distances[u] + edge.weight;
+            if (newDist < distances[edge.dest])
             {
-                minWeight = edge.weight;
-                nextEdge = edge.dest;
+                distances[edge.dest] = newDist;
+                parents[edge.dest] = u;
+                open.insertOrDecrease(edge.dest, newDist + estimate(edge.dest));
             }
         }
-        tour.push_back(nextEdge);
-        totalWeight += minWeight;
-        visited[nextEdge] = true;
-        current = nextEdge;
     }
 
-    tour.push_back(start);
-    totalWeight += adj[current].find({current, start})->weight;
+    std::vector<int> path;
+    if (distances[target] != ShortestPathTree::Unreachable)
+        path = tracePath(parents, target);
 
     std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start_time;
-    return std::make_pair(std::make_pair(tour, totalWeight), duration.count());
+    return std::make_pair(std::make_pair(path, distances[target]), duration.count());
 }
 
-std::pair<std::pair<std::vector<int>, int>, double> Graph::doubleTreeTSP(int start) const
+// Per-worker state reused by consecutive batch queries. Only the entries touched by a query are reset.
+struct DijkstraScratch
 {
-    auto start_time = std::chrono::high_resolution_clock::now();
+    IndexedMinHeap<int> heap;
+    std::vector<bool> settled;
+    std::vector<int> touched;
 
-    std::vector<VertexInfo> mst = primMST(start);
-    std::vector<int> preorder = preorderWalk(mst);
+    DijkstraScratch(int V) : heap(V), settled(V, false) {}
+};
 
-    preorder.push_back(preorder.front());
+// Dijkstra writing straight into caller-provided rows, distances must be pre-filled with the unreachable value.
+static void dijkstraInto(const CsrGraph &graph, int source, DijkstraScratch &scratch, int *distances, int *parents)
+{
+    distances[source] = 0;
+    scratch.heap.insert(source, 0);
 
-    int totalWeight = 0;
-    for (auto i = 0; i < preorder.size() - 1; ++i)
+    while (!scratch.heap.isEmpty())
     {
-        int u = preorder[i];
-        int v = preorder[i + 1];
-
-        auto it = std::find_if(adj[u].begin(), adj[u].end(), [v](const Edge &e)
-                               { return e.dest == v; });
+        int u = scratch.heap.extractMin().second;
+        scratch.settled[u] = true;
+        scratch.touched.push_back(u);
 
-        if (it != adj[u].end())
-            totalWeight += it->weight;
+        for (const Arc &edge : graph.neighbors(u))
+        {
+            int newDist = distances[u] + edge.weight;
+            if (!scratch.settled[edge.dest] && newDist < distances[edge.dest])
+            {
+                distances[edge.dest] = newDist;
+                if (parents != nullptr)
+                    parents[edge.dest] = u;
+                scratch.heap.insertOrDecrease(edge.dest, newDist);
+            }
+        }
     }
 
-    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start_time;
-    return std::make_pair(std::make_pair(preorder, totalWeight), duration.count());
+    for (int v : scratch.touched)
+        scratch.settled[v] = false;
+    scratch.touched.clear();
 }
 
-std::pair<std::pair<std::vector<int>, int>, double> Graph::randomInsertionTSP(int start1, int start2) const
+double Graph::dijkstraBatch(const std::vector<int> &sources, int *distances, int *parents, ThreadPool &pool) const
 {
+    const CsrGraph &graph = freeze();
+    for (int source : sources)
+        checkVertex(source);
+
     auto start_time = std::chrono::high_resolution_clock::now();
 
-    std::vector<int> tour;
-    tour.push_back(start1);
-    tour.push_back(start2);
+    std::vector<std::unique_ptr<DijkstraScratch>> scratches(pool.size());
+    pool.parallelFor(static_cast<int>(sources.size()), 1, [&](int worker, int begin, int end)
+                     {
+        if (!scratches[worker])
+            scratches[worker] = std::make_unique<DijkstraScratch>(V);
 
-    int totalWeight = adj[start1].find({start1, start2, 0})->weight;
+        for (int k = begin; k < end; ++k)
+        {
+            int *distanceRow = distances + static_cast<std::size_t>(k) * V;
+            int *parentRow = parents != nullptr ? parents + static_cast<std::size_t>(k) * V : nullptr;
+            std::fill(distanceRow, distanceRow + V, ShortestPathTree::Unreachable);
+            if (parentRow != nullptr)
+                std::fill(parentRow, parentRow + V, -1);
 
-    std::vector<int> unvisited;
-    for (auto i = 0; i < V; ++i)
-    {
-        if (i == start1 || i == start2)
-            continue;
+            dijkstraInto(graph, sources[k], *scratches[worker], distanceRow, parentRow);
+        } });
 
-        unvisited.push_back(i);
-    }
+    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start_time;
+    return duration.count();
+}
 
-    while (!unvisited.empty())
+double Graph::dijkstraBatch(const std::vector<int> &sources, int *distances, int *parents, int threads) const
+{
+    ThreadPool pool(threads);
+    return dijkstraBatch(sources, distances, parents, pool);
+}
+
+std::vector<VertexInfo> Graph::primMST(int start) const
+{
+    return ::primMST(freeze(), start);
+}
+
+std::pair<SpanningForest, double> Graph::mst(MstAlgorithm algorithm, int threads) const
+{
+    const CsrGraph &graph = freeze();
+    if (algorithm == MstAlgorithm::Prim)
     {
-        int randIndex = rand() % unvisited.size();
-        int newVertex = unvisited[randIndex];
-        unvisited.erase(unvisited.begin() + randIndex);
+        auto start_time = std::chrono::high_resolution_clock::now();
+        SpanningForest forest = primMSF(graph);
+        std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start_time;
+        return std::make_pair(std::move(forest), duration.count());
+    }
 
-        int bestDiff = std::numeric_limits<int>::max();
-        int insertIndex = -1;
-        for (auto i = 1; i < tour.size(); ++i)
-        {
-            int u = tour[i - 1];
-            int v = tour[i];
+    ThreadPool pool(threads);
+    auto start_time = std::chrono::high_resolution_clock::now();
+    SpanningForest forest = algorithm == MstAlgorithm::Boruvka ? boruvkaMSF(graph, pool) : filterKruskalMSF(graph, pool);
+    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start_time;
+    return std::make_pair(std::move(forest), duration.count());
+}
 
-            int diff = adj[u].find({u, newVertex, 0})->weight + adj[newVertex].find({newVertex, v, 0})->weight - adj[u].find({u, v, 0})->weight;
-            if (diff < bestDiff)
-            {
-                bestDiff = diff;
-                insertIndex = i;
-            }
-        }
+std::vector<int> Graph::preorderWalk(const std::vector<VertexInfo> &mst) const
+{
+    return ::preorderWalk(V, mst);
+}
 
-        tour.insert(tour.begin() + insertIndex, newVertex);
-        totalWeight += bestDiff;
-    }
+std::pair<std::pair<std::vector<int>, int>, double> Graph::nearestNeighborTSP(int start) const
+{
+    const CsrGraph &graph = freeze();
+    return ::nearestNeighborTSP(graph, start);
+}
 
-    totalWeight += adj[tour.back()].find({tour.back(), tour.front(), 0})->weight;
-    tour.push_back(tour.front());
+std::pair<std::pair<std::vector<int>, int>, double> Graph::doubleTreeTSP(int start) const
+{
+    const CsrGraph &graph = freeze();
+    return ::doubleTreeTSP(graph, start);
+}
 
-    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start_time;
-    return std::make_pair(std::make_pair(tour, totalWeight), duration.count());
+std::pair<std::pair<std::vector<int>, int>, double> Graph::christofidesTSP(int start) const
+{
+    const CsrGraph &graph = freeze();
+    return ::christofidesTSP(graph, start);
+}
+
+std::pair<std::pair<std::vector<int>, int>, double> Graph::hilbertCurveTSP(int start) const
+{
+    if (cities.empty())
+        throw std::invalid_argument("The Hilbert curve heuristic requires a graph built from cities.");
+
+    return ::hilbertCurveTSP(freeze(), cities, start);
+}
+
+std::pair<std::pair<std::vector<int>, int>, double> Graph::randomInsertionTSP(int start1, int start2, unsigned seed) const
+{
+    const CsrGraph &graph = freeze();
+    return ::randomInsertionTSP(graph, start1, start2, {}, seed);
 }
 
-std::unordered_map<int, City> City::generateRandomGraphCities(int n)
+std::unordered_map<int, City> City::generateRandomGraphCities(int n, unsigned seed)
 {
+    std::mt19937 rng(seed);
     std::unordered_map<int, City> cities;
     std::uniform_int_distribution<int> coordinate(0, 2000);
 
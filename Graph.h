@@ -3,8 +3,18 @@
 
 #include <vector>
 #include <unordered_set>
+#include <unordered_map>
 #include <utility>
 #include <iostream>
+#include <memory>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <cstdint>
+#include "CsrGraph.h"
+#include "ThreadPool.h"
+#include "ShortestPathTree.h"
+#include "SpanningForest.h"
 
 // Edge represents a connection between two vertices in a graph.
 // Implemented for undirected graphs.
@@ -50,12 +60,13 @@ struct City
 
     double distance(const City &other) const
     {
-        int dx = x - other.x;
-        int dy = y - other.y;
+        // Wide enough for geographic coordinates in millionths of a degree, as in the DIMACS road graphs.
+        double dx = static_cast<double>(x) - other.x;
+        double dy = static_cast<double>(y) - other.y;
         return sqrt(dx * dx + dy * dy);
     }
 
-    static std::unordered_map<int, City> generateRandomGraphCities(int n);
+    static std::unordered_map<int, City> generateRandomGraphCities(int n, unsigned seed = std::random_device{}());
 };
 
 // VertexInfo represents a vertex in a graph with additional information for algorithms and traversals.
@@ -103,46 +114,138 @@ public:
     };
 };
 
+// Estimates the remaining path weight between two cities. A* returns shortest paths only if it never overestimates.
+using CityHeuristic = std::function<int(const City &from, const City &to)>;
+
+// Point-to-point search strategies for Graph::shortestPath.
+enum class PathSearch
+{
+    Dijkstra,
+    Bidirectional,
+    AStar
+};
+
+// Minimum spanning forest engines for Graph::mst.
+enum class MstAlgorithm
+{
+    Prim,
+    Boruvka,
+    FilterKruskal
+};
+
 // Graph represents a collection of vertices and edges.
 // Implemented for undirected graphs.
 class Graph
 {
 private:
     int V;
-    std::unordered_set<Edge, Edge::AdjListHash, Edge::AdjListEquals> *adj;
+    // Hash-set adjacency for edits. Graphs built from a CSR snapshot leave it null until their first edit (thaw).
+    std::unordered_set<Edge, Edge::AdjListHash, Edge::AdjListEquals> *adj = nullptr;
+    mutable std::unique_ptr<CsrGraph> csr;
+    // Coordinates of vertex i at index i, only for graphs built from cities.
+    std::vector<City> cities;
+    // City key of every vertex and the vertex of every city key, only for graphs renumbered in spatial order.
+    std::vector<int> originalIds;
+    std::vector<int> vertexIds;
+    // Smallest ratio of edge weight to straight-line edge length, computed by the first default A* search after each
+    // snapshot build (negative until then) so loading a mapped graph file reads no arcs.
+    mutable double straightLineScale = -1;
+
+    // Builds the hash-set adjacency from the CSR snapshot before the first edit.
+    void thaw();
+    // Recomputes straightLineScale from the snapshot and the city coordinates.
+    void updateStraightLineScale() const;
+    // Throws out_of_range unless the vertex is in [0, V).
+    void checkVertex(int vertex) const;
 
 public:
-    // Random weighted complete graph generator.
+    // Random weighted complete graph generator, with a random seed and every hardware thread.
     Graph(int V);
     // Random weighted graph generator with edge count for each vertex in range [KMin, KMax].
     Graph(int V, int KMin, int KMax);
     Graph(int V, const std::vector<Edge> &edges);
-    Graph(const std::unordered_map<int, City> &cities);
+    // Wraps a prepared snapshot, for example one mapped by mapGraphFile, with the coordinates of its vertices if there
+    // are any. Read-only use never builds the hash-set adjacency.
+    explicit Graph(CsrGraph graph, std::vector<City> cities = {});
+    // Maps a graph file written by save together with its coordinates. Nothing is copied until the first edit.
+    explicit Graph(const std::string &path);
+    // Complete graph over the cities with truncated straight-line weights. City i of the map becomes vertex i, unless
+    // spatialOrder is set: then vertices are numbered along the Hilbert curve through the cities, so that nearby cities
+    // are nearby in memory, and originalId/vertexOf translate between the two numberings.
+    Graph(const std::unordered_map<int, City> &cities, bool spatialOrder = false);
     ~Graph() { delete[] adj; }
 
+    // Seeded versions of the random generators. Equal seeds generate equal graphs for any thread count; non-positive
+    // threads uses every hardware thread. See GraphGenerators.h.
+    static Graph complete(int V, std::uint64_t seed, int threads = 0);
+    static Graph randomDegree(int V, int KMin, int KMax, std::uint64_t seed, int threads = 0);
+
     bool addEdge(const Edge &edge);
     bool removeEdge(const Edge &edge);
     bool hasEdge(const Edge &edge) const;
     int verticesCount() const { return V; }
-
-    std::pair<std::unordered_map<int, VertexInfo>, double> dijkstraMinHeap(int sourceKey) const;
-    std::pair<std::unordered_map<int, VertexInfo>, double> dijkstraFibHeap(int sourceKey) const;
-    static void printDijkstraResults(int source, const std::unordered_map<int, VertexInfo> &distances);
+    bool hasCoordinates() const { return !cities.empty(); }
+    const std::vector<City> &cityCoordinates() const { return cities; }
+    // Translation between vertices and the city keys the graph was built from; the identity unless renumbered.
+    int originalId(int vertex) const { return originalIds.empty() ? vertex : originalIds[vertex]; }
+    int vertexOf(int originalId) const { return vertexIds.empty() ? originalId : vertexIds[originalId]; }
+    std::vector<int> toOriginalIds(const std::vector<int> &path) const;
+    // Writes the snapshot and the coordinates to a graph file, see GraphFile.h.
+    void save(const std::string &path) const;
+
+    // Builds (or returns the cached) read-only CSR snapshot all traversal algorithms run on.
+    // Any successful addEdge/removeEdge invalidates the snapshot. The first call is not thread-safe.
+    // The durations the algorithms below return exclude building the snapshot: each one freezes the graph before its
+    // clock starts, so call freeze() up front when the first of several timed runs must be comparable with the rest.
+    const CsrGraph &freeze() const;
+
+    // Vertices enter the heap only once they are first reached. If targetKey is given, the search stops as soon
+    // as the target is settled, leaving the vertices that were not settled yet with tentative distances.
+    // Sources and targets outside [0, V) throw out_of_range, here and in the searches below.
+    std::pair<ShortestPathTree, double> dijkstraMinHeap(int sourceKey, int targetKey = -1) const;
+    // The Fibonacci heap variant instead seeds every vertex at once with FibonacciHeap::insertAll, as in CLRS, and
+    // lowers keys through the returned node array.
+    std::pair<ShortestPathTree, double> dijkstraFibHeap(int sourceKey, int targetKey = -1) const;
+    // Dijkstra over a monotone integer queue: Dial's buckets for small maximum weights, radix heap otherwise.
+    std::pair<ShortestPathTree, double> dijkstraBucket(int sourceKey, int targetKey = -1) const;
+    // Parallel delta-stepping single-source shortest paths. Non-positive delta picks maxWeight / averageDegree,
+    // non-positive threads uses every hardware thread.
+    std::pair<ShortestPathTree, double> deltaStepping(int sourceKey, int delta = 0, int threads = 0) const;
+    // Shortest path between two vertices with its weight, or an empty path if the target is unreachable.
+    // PathSearch::AStar uses the straight-line distance heuristic and requires city coordinates.
+    std::pair<std::pair<std::vector<int>, int>, double> shortestPath(int sourceKey, int targetKey, PathSearch search = PathSearch::Bidirectional) const;
+    // A* over city coordinates. The default heuristic is the straight-line distance scaled by the smallest ratio of edge
+    // weight to edge length in the graph, which keeps it admissible for the truncated weights of Graph(cities).
+    // The ratio is computed by the first such search after each snapshot build, outside the measured duration; like the
+    // first freeze(), that call is not thread-safe.
+    std::pair<std::pair<std::vector<int>, int>, double> shortestPathAStar(int sourceKey, int targetKey, const CityHeuristic &heuristic = nullptr) const;
+
+    // Runs one Dijkstra per source on the pool, reusing per-worker heaps between queries. Row k of the caller-provided
+    // V * sources.size() arrays receives the distances (and, if parents is not null, the parents) from sources[k].
+    // Unreachable vertices keep distance numeric_limits<int>::max() / 2 and parent -1. Returns the duration.
+    double dijkstraBatch(const std::vector<int> &sourceKeys, int *distances, int *parents, ThreadPool &pool) const;
+    double dijkstraBatch(const std::vector<int> &sourceKeys, int *distances, int *parents, int threads = 0) const;
 
     std::vector<VertexInfo> primMST(int start) const;
+    // Minimum spanning forest, one tree per connected component, with its duration. Borůvka and filter-Kruskal run on
+    // a pool of the given size (non-positive uses every hardware thread) and return the same forest; Prim is sequential.
+    std::pair<SpanningForest, double> mst(MstAlgorithm algorithm = MstAlgorithm::Boruvka, int threads = 0) const;
     std::vector<int> preorderWalk(const std::vector<VertexInfo> &mst) const;
 
     std::pair<std::pair<std::vector<int>, int>, double> nearestNeighborTSP(int start) const;
     std::pair<std::pair<std::vector<int>, int>, double> doubleTreeTSP(int start) const;
-    std::pair<std::pair<std::vector<int>, int>, double> randomInsertionTSP(int start1, int start2) const;
+    std::pair<std::pair<std::vector<int>, int>, double> christofidesTSP(int start) const;
+    // Requires city coordinates.
+    std::pair<std::pair<std::vector<int>, int>, double> hilbertCurveTSP(int start) const;
+    std::pair<std::pair<std::vector<int>, int>, double> randomInsertionTSP(int start1, int start2, unsigned seed = 0) const;
 
     friend std::ostream &operator<<(std::ostream &os, const Graph &obj)
     {
         for (int i = 0; i < obj.V; ++i)
         {
             os << i << " -> ";
-            for (const auto &vertex : obj.adj[i])
-                os << vertex.dest << "(" << vertex.weight << "), ";
+            for (const Arc &arc : obj.freeze().neighbors(i))
+                os << arc.dest << "(" << arc.weight << "), ";
             os << "NULL" << std::endl;
         }
         return os;
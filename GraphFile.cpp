@@ -0,0 +1,243 @@
+#include "GraphFile.h"
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <limits>
+
+#ifdef _WIN32
+#include <memory>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Sections start at multiples of this many bytes, which keeps every array aligned for its element type.
+static constexpr std::int64_t SectionAlignment = 64;
+
+static std::int64_t alignSection(std::int64_t position)
+{
+    return (position + SectionAlignment - 1) / SectionAlignment * SectionAlignment;
+}
+
+// Byte positions of the sections for the given sizes; the last entry is the file size.
+struct GraphFileLayout
+{
+    std::int64_t offsets;
+    std::int64_t targets;
+    std::int64_t weights;
+    std::int64_t coordinates;
+    std::int64_t size;
+
+    GraphFileLayout(std::int64_t V, std::int64_t E, bool withCoordinates)
+    {
+        offsets = sizeof(GraphFileHeader);
+        targets = alignSection(offsets + (V + 1) * static_cast<std::int64_t>(sizeof(std::int64_t)));
+        weights = alignSection(targets + E * static_cast<std::int64_t>(sizeof(std::int32_t)));
+        coordinates = alignSection(weights + E * static_cast<std::int64_t>(sizeof(std::int32_t)));
+        size = withCoordinates ? coordinates + V * 2 * static_cast<std::int64_t>(sizeof(std::int32_t)) : coordinates;
+    }
+};
+
+static void writeSection(std::ofstream &file, std::int64_t position, const void *data, std::int64_t bytes)
+{
+    static const char zeros[SectionAlignment] = {};
+    std::int64_t gap = position - static_cast<std::int64_t>(file.tellp());
+    file.write(zeros, gap);
+    if (bytes > 0)
+        file.write(static_cast<const char *>(data), bytes);
+}
+
+void writeGraphFile(const std::string &path, const CsrGraph &graph, const std::vector<City> *cities)
+{
+    std::int64_t V = graph.verticesCount();
+    std::int64_t E = graph.arcsCount();
+    bool withCoordinates = cities != nullptr && !cities->empty();
+    if (withCoordinates && static_cast<std::int64_t>(cities->size()) != V)
+        throw std::invalid_argument("There must be one city per vertex.");
+
+    GraphFileHeader header{};
+    std::memcpy(header.magic, GraphFileHeader::Magic, sizeof(header.magic));
+    header.version = GraphFileHeader::CurrentVersion;
+    header.byteOrder = GraphFileHeader::ByteOrderMark;
+    header.flags = withCoordinates ? GraphFileHeader::HasCoordinates : 0;
+    header.minWeight = graph.minWeight();
+    header.maxWeight = graph.maxWeight();
+    header.verticesCount = V;
+    header.arcsCount = E;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        throw std::runtime_error("Could not open " + path + " for writing.");
+
+    GraphFileLayout layout(V, E, withCoordinates);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    writeSection(file, layout.offsets, graph.offsetsData(), (V + 1) * sizeof(std::int64_t));
+    writeSection(file, layout.targets, graph.targetsData(), E * sizeof(std::int32_t));
+    writeSection(file, layout.weights, graph.weightsData(), E * sizeof(std::int32_t));
+    if (withCoordinates)
+    {
+        std::vector<std::int32_t> coordinates;
+        coordinates.reserve(2 * V);
+        for (const City &city : *cities)
+        {
+            coordinates.push_back(city.x);
+            coordinates.push_back(city.y);
+        }
+        writeSection(file, layout.coordinates, coordinates.data(), 2 * V * sizeof(std::int32_t));
+    }
+    else
+        writeSection(file, layout.coordinates, nullptr, 0);
+
+    if (!file.flush())
+        throw std::runtime_error("Could not write " + path + ".");
+}
+
+#ifdef _WIN32
+// Without mmap the file is read into one buffer, which then plays the part of the mapping.
+class GraphFileMapping
+{
+public:
+    explicit GraphFileMapping(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+            throw std::runtime_error("Could not open " + path + ".");
+
+        length = static_cast<std::size_t>(file.tellg());
+        buffer.reset(new std::int64_t[(length + sizeof(std::int64_t) - 1) / sizeof(std::int64_t)]);
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char *>(buffer.get()), length))
+            throw std::runtime_error("Could not read " + path + ".");
+    }
+
+    const char *data() const { return reinterpret_cast<const char *>(buffer.get()); }
+    std::size_t size() const { return length; }
+
+private:
+    std::unique_ptr<std::int64_t[]> buffer;
+    std::size_t length = 0;
+};
+#else
+// Read-only private mapping of a whole file, unmapped when destroyed.
+class GraphFileMapping
+{
+public:
+    explicit GraphFileMapping(const std::string &path)
+    {
+        int descriptor = open(path.c_str(), O_RDONLY);
+        if (descriptor < 0)
+            throw std::runtime_error("Could not open " + path + ".");
+
+        struct stat status;
+        if (fstat(descriptor, &status) != 0)
+        {
+            close(descriptor);
+            throw std::runtime_error("Could not read " + path + ".");
+        }
+
+        length = static_cast<std::size_t>(status.st_size);
+        if (length > 0)
+            address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        // The mapping stays valid after the descriptor is closed.
+        close(descriptor);
+        if (address == MAP_FAILED)
+            throw std::runtime_error("Could not map " + path + ".");
+    }
+
+    ~GraphFileMapping()
+    {
+        if (address != nullptr && address != MAP_FAILED)
+            munmap(address, length);
+    }
+
+    GraphFileMapping(const GraphFileMapping &) = delete;
+    GraphFileMapping &operator=(const GraphFileMapping &) = delete;
+
+    const char *data() const { return static_cast<const char *>(address); }
+    std::size_t size() const { return length; }
+
+private:
+    void *address = nullptr;
+    std::size_t length = 0;
+};
+#endif
+
+// Checks everything the algorithms rely on without bounds checks: rows within the arcs and in order, targets in
+// [0, V) and sorted within each row, and the weight bounds of the header (which size Dial's buckets) equal to the
+// actual ones. One pass over the mapped arrays, nothing copied.
+static void validateArrays(const std::string &path, int V, const std::int64_t *offsets, const int *targets, const int *weights,
+                           const GraphFileHeader &header)
+{
+    if (offsets[0] != 0 || offsets[V] != header.arcsCount)
+        throw std::runtime_error(path + " has inconsistent offsets.");
+
+    int minWeight = std::numeric_limits<int>::max();
+    int maxWeight = std::numeric_limits<int>::min();
+    for (int u = 0; u < V; ++u)
+    {
+        if (offsets[u + 1] < offsets[u])
+            throw std::runtime_error(path + " has inconsistent offsets.");
+
+        for (std::int64_t arc = offsets[u]; arc < offsets[u + 1]; ++arc)
+        {
+            if (targets[arc] < 0 || targets[arc] >= V || (arc > offsets[u] && targets[arc] <= targets[arc - 1]))
+                throw std::runtime_error(path + " has an invalid or unsorted target in the row of vertex " + std::to_string(u) + ".");
+            minWeight = std::min(minWeight, weights[arc]);
+            maxWeight = std::max(maxWeight, weights[arc]);
+        }
+    }
+
+    if (header.arcsCount == 0)
+        minWeight = maxWeight = 0;
+    if (minWeight != header.minWeight || maxWeight != header.maxWeight)
+        throw std::runtime_error(path + " has weight bounds that do not match its weights.");
+}
+
+CsrGraph mapGraphFile(const std::string &path, std::vector<City> *cities)
+{
+    auto mapping = std::make_shared<GraphFileMapping>(path);
+    if (mapping->size() < sizeof(GraphFileHeader))
+        throw std::runtime_error(path + " is not a graph file.");
+
+    GraphFileHeader header;
+    std::memcpy(&header, mapping->data(), sizeof(header));
+    if (std::memcmp(header.magic, GraphFileHeader::Magic, sizeof(header.magic)) != 0)
+        throw std::runtime_error(path + " is not a graph file.");
+    if (header.byteOrder != GraphFileHeader::ByteOrderMark)
+        throw std::runtime_error(path + " was written with a different byte order.");
+    if (header.version != GraphFileHeader::CurrentVersion)
+        throw std::runtime_error(path + " has unsupported graph file version " + std::to_string(header.version) + ".");
+
+    std::int64_t V = header.verticesCount;
+    std::int64_t E = header.arcsCount;
+    bool withCoordinates = (header.flags & GraphFileHeader::HasCoordinates) != 0;
+    if (V < 0 || V > std::numeric_limits<int>::max() || E < 0 || E > static_cast<std::int64_t>(mapping->size()))
+        throw std::runtime_error(path + " has a corrupt header.");
+
+    GraphFileLayout layout(V, E, withCoordinates);
+    if (layout.size > static_cast<std::int64_t>(mapping->size()))
+        throw std::runtime_error(path + " is truncated.");
+
+    const char *base = mapping->data();
+    auto offsets = reinterpret_cast<const std::int64_t *>(base + layout.offsets);
+    auto targets = reinterpret_cast<const int *>(base + layout.targets);
+    auto weights = reinterpret_cast<const int *>(base + layout.weights);
+    validateArrays(path, static_cast<int>(V), offsets, targets, weights, header);
+
+    if (cities)
+    {
+        cities->clear();
+        if (withCoordinates)
+        {
+            auto coordinates = reinterpret_cast<const std::int32_t *>(base + layout.coordinates);
+            cities->reserve(V);
+            for (int v = 0; v < V; ++v)
+                cities->emplace_back(v, coordinates[2 * v], coordinates[2 * v + 1]);
+        }
+    }
+
+    return CsrGraph(static_cast<int>(V), offsets, targets, weights, header.minWeight, header.maxWeight, mapping);
+}
@@ -0,0 +1,47 @@
+#ifndef GRAPH_FILE_H
+#define GRAPH_FILE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "CsrGraph.h"
+#include "Graph.h"
+
+// Binary graph file: a CSR snapshot laid out so it can be memory-mapped and used in place.
+//
+// A 64-byte header is followed by these sections, each starting at a multiple of 64 bytes:
+// offsets (V + 1 x int64), targets (E x int32), weights (E x int32) and optionally the coordinates (V x two int32).
+// Values use the writer's byte order, which the header records, so loading on a machine with the other order fails
+// instead of misreading the graph. Readers reject any version they do not know.
+struct GraphFileHeader
+{
+    static constexpr char Magic[8] = {'C', 'S', 'R', 'G', 'R', 'A', 'P', 'H'};
+    static constexpr std::uint32_t CurrentVersion = 1;
+    static constexpr std::uint32_t ByteOrderMark = 0x01020304;
+    static constexpr std::uint32_t HasCoordinates = 1;
+
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint32_t flags;
+    std::int32_t minWeight;
+    std::int32_t maxWeight;
+    std::int32_t reserved;
+    std::int64_t verticesCount;
+    std::int64_t arcsCount;
+    std::int64_t padding[2];
+};
+
+static_assert(sizeof(GraphFileHeader) == 64, "The graph file header must stay 64 bytes.");
+
+// Writes the snapshot, and the city coordinates of its vertices if cities is not null. Throws runtime_error on I/O
+// failure.
+void writeGraphFile(const std::string &path, const CsrGraph &graph, const std::vector<City> *cities = nullptr);
+
+// Maps a graph file and returns a view of it; nothing is copied or rebuilt, and the mapping lives as long as any copy of
+// the view. The offsets, targets and weight bounds are validated in one read-only pass over the arrays, so a corrupt
+// file cannot make an algorithm index out of range. If cities is not null it receives the coordinates (empty if the
+// file has none). Throws runtime_error for unreadable or malformed files.
+CsrGraph mapGraphFile(const std::string &path, std::vector<City> *cities = nullptr);
+
+#endif // GRAPH_FILE_H
@@ -0,0 +1,526 @@
+#include "GraphGenerators.h"
+#include "CounterRng.h"
+#include <algorithm>
+#include <stdexcept>
+#include <cmath>
+#include <limits>
+
+// Rows per parallel chunk.
+static constexpr int RowGrain = 64;
+// Topology draws use streams of a seed derived from the weight seed, so the two never share random numbers.
+static constexpr std::uint64_t TopologySalt = 0x243f6a8885a308d3ull;
+// Stream of the stub shuffle, apart from the per-vertex streams.
+static constexpr std::uint64_t ShuffleStream = ~0ull;
+// Random partners or edges tried per missing edge while repairing the configuration model.
+static constexpr int RepairAttempts = 1 << 12;
+
+// Weight of edge (u, v): element max(u, v) of stream min(u, v), the same from both rows.
+static int pairWeight(std::uint64_t seed, int u, int v, int minWeight, int maxWeight)
+{
+    return CounterRng(seed, std::min(u, v)).uniformIntAt(std::max(u, v), minWeight, maxWeight);
+}
+
+static void checkWeights(int minWeight, int maxWeight)
+{
+    if (minWeight > maxWeight)
+        throw std::invalid_argument("The minimum weight must not exceed the maximum weight.");
+}
+
+// CSR snapshot of sorted, symmetric adjacency rows with pair weights.
+static CsrGraph rowsToCsr(const std::vector<std::vector<int>> &rows, std::uint64_t seed, ThreadPool &pool, int minWeight, int maxWeight)
+{
+    int V = static_cast<int>(rows.size());
+    std::vector<std::int64_t> offsets(V + 1, 0);
+    for (int u = 0; u < V; ++u)
+        offsets[u + 1] = offsets[u] + static_cast<std::int64_t>(rows[u].size());
+
+    std::vector<int> targets(offsets[V]);
+    std::vector<int> weights(offsets[V]);
+    pool.parallelFor(V, RowGrain, [&](int, int begin, int end)
+                     {
+                         for (int u = begin; u < end; ++u)
+                         {
+                             std::int64_t pos = offsets[u];
+                             for (int v : rows[u])
+                             {
+                                 targets[pos] = v;
+                                 weights[pos++] = pairWeight(seed, u, v, minWeight, maxWeight);
+                             }
+                         } });
+
+    return CsrGraph(V, std::move(offsets), std::move(targets), std::move(weights));
+}
+
+// Erased configuration model: every vertex gets degrees[v] stubs, the shuffled stubs are paired up, and self-loops and
+// repeated edges are dropped. O(V + E) apart from sorting each row. Returns sorted adjacency rows.
+static std::vector<std::vector<int>> matchStubs(const std::vector<int> &degrees, std::uint64_t seed, ThreadPool &pool)
+{
+    int V = static_cast<int>(degrees.size());
+    std::vector<int> stubs;
+    for (int v = 0; v < V; ++v)
+        stubs.insert(stubs.end(), degrees[v], v);
+    if (stubs.size() >= (std::uint64_t(1) << 32))
+        throw std::invalid_argument("The degree sequence has too many edges.");
+
+    // Fisher-Yates on one stream; multiply-shift picks j in [0, i].
+    CounterRng rng(seed, ShuffleStream);
+    for (std::size_t i = stubs.size(); i > 1; --i)
+    {
+        std::size_t j = static_cast<std::size_t>(((rng() >> 32) * i) >> 32);
+        std::swap(stubs[i - 1], stubs[j]);
+    }
+
+    std::vector<int> counts(V, 0);
+    for (std::size_t i = 0; i + 1 < stubs.size(); i += 2)
+    {
+        ++counts[stubs[i]];
+        ++counts[stubs[i + 1]];
+    }
+
+    std::vector<std::vector<int>> rows(V);
+    for (int v = 0; v < V; ++v)
+        rows[v].reserve(counts[v]);
+    for (std::size_t i = 0; i + 1 < stubs.size(); i += 2)
+    {
+        int a = stubs[i];
+        int b = stubs[i + 1];
+        if (a == b)
+            continue;
+
+        rows[a].push_back(b);
+        rows[b].push_back(a);
+    }
+
+    // A repeated edge appears in both of its rows, so removing duplicates row by row keeps them symmetric.
+    pool.parallelFor(V, RowGrain, [&](int, int begin, int end)
+                     {
+                         for (int v = begin; v < end; ++v)
+                         {
+                             std::sort(rows[v].begin(), rows[v].end());
+                             rows[v].erase(std::unique(rows[v].begin(), rows[v].end()), rows[v].end());
+                         } });
+    return rows;
+}
+
+static bool adjacent(const std::vector<std::vector<int>> &rows, int u, int v)
+{
+    return std::binary_search(rows[u].begin(), rows[u].end(), v);
+}
+
+static void link(std::vector<std::vector<int>> &rows, int u, int v)
+{
+    rows[u].insert(std::lower_bound(rows[u].begin(), rows[u].end(), v), v);
+    rows[v].insert(std::lower_bound(rows[v].begin(), rows[v].end(), u), u);
+}
+
+static void unlink(std::vector<std::vector<int>> &rows, int u, int v)
+{
+    rows[u].erase(std::lower_bound(rows[u].begin(), rows[u].end(), v));
+    rows[v].erase(std::lower_bound(rows[v].begin(), rows[v].end(), u));
+}
+
+// Raises every vertex below KMin, which only happens where the configuration model dropped loops and repeated edges.
+// A vertex joins a random vertex below KMax first; if none is found, a random edge (x, y) is replaced by (u, x) and
+// (w, y) for w = u or another deficient vertex, which keeps the degrees of x and y.
+static void repairDegrees(std::vector<std::vector<int>> &rows, int KMin, int KMax, std::uint64_t seed)
+{
+    int V = static_cast<int>(rows.size());
+    auto degree = [&rows](int v)
+    { return static_cast<int>(rows[v].size()); };
+
+    std::vector<int> deficient;
+    for (int v = 0; v < V; ++v)
+    {
+        if (degree(v) < KMin)
+            deficient.push_back(v);
+    }
+
+    for (int u : deficient)
+    {
+        CounterRng rng(seed, static_cast<std::uint64_t>(V) + u);
+        int attempts = 0;
+        while (degree(u) < KMin)
+        {
+            if (++attempts > RepairAttempts)
+                throw std::runtime_error("Could not generate a graph with the specified number of edges.");
+
+            int w = rng.uniformInt(0, V - 1);
+            if (w != u && degree(w) < KMax && !adjacent(rows, u, w))
+            {
+                link(rows, u, w);
+                attempts = 0;
+                continue;
+            }
+
+            int x = rng.uniformInt(0, V - 1);
+            if (x == u || degree(x) == 0 || adjacent(rows, u, x))
+                continue;
+            int y = rows[x][rng.uniformInt(0, degree(x) - 1)];
+            if (y == u)
+                continue;
+
+            // The second new edge goes to y from u itself while u has room for two more edges, otherwise from another
+            // deficient vertex; an even degree sum guarantees one exists when KMin = KMax.
+            int partner = u;
+            if (degree(u) + 2 > KMax)
+            {
+                partner = -1;
+                for (int v : deficient)
+                {
+                    if (v != u && degree(v) < KMin)
+                    {
+                        partner = v;
+                        break;
+                    }
+                }
+            }
+            if (partner == -1 || partner == x || partner == y || adjacent(rows, partner, y))
+                continue;
+
+            unlink(rows, x, y);
+            link(rows, u, x);
+            link(rows, partner, y);
+            attempts = 0;
+        }
+    }
+}
+
+CsrGraph csrFromEdges(int V, const std::vector<Edge> &edges, ThreadPool &pool)
+{
+    if (V < 0)
+        throw std::invalid_argument("The number of vertices must be non-negative.");
+
+    std::vector<std::int64_t> offsets(V + 1, 0);
+    for (const Edge &edge : edges)
+    {
+        if (edge.src < 0 || edge.dest < 0 || edge.src >= V || edge.dest >= V)
+            throw std::invalid_argument("The vertices must be within the range of the graph.");
+        if (edge.src == edge.dest)
+            continue;
+
+        ++offsets[edge.src + 1];
+        ++offsets[edge.dest + 1];
+    }
+    for (int v = 0; v < V; ++v)
+        offsets[v + 1] += offsets[v];
+
+    // Arcs enter each row in edge order. Rows are then sorted on (target, position in row) in parallel, so the first
+    // copy of a repeated edge stays in front and the result does not depend on the thread count.
+    std::vector<int> targets(offsets[V]);
+    std::vector<int> weights(offsets[V]);
+    std::vector<std::int64_t> fill(offsets.begin(), offsets.end() - 1);
+    for (const Edge &edge : edges)
+    {
+        if (edge.src == edge.dest)
+            continue;
+
+        targets[fill[edge.src]] = edge.dest;
+        weights[fill[edge.src]++] = edge.weight;
+        targets[fill[edge.dest]] = edge.src;
+        weights[fill[edge.dest]++] = edge.weight;
+    }
+
+    std::vector<std::int64_t> kept(V + 1, 0);
+    pool.parallelFor(V, RowGrain, [&](int, int begin, int end)
+                     {
+                         std::vector<std::uint64_t> keys;
+                         std::vector<int> rowWeights;
+                         for (int u = begin; u < end; ++u)
+                         {
+                             std::int64_t first = offsets[u];
+                             int degree = static_cast<int>(offsets[u + 1] - first);
+                             keys.resize(degree);
+                             rowWeights.assign(weights.begin() + first, weights.begin() + first + degree);
+                             for (int i = 0; i < degree; ++i)
+                                 keys[i] = (static_cast<std::uint64_t>(targets[first + i]) << 32) | static_cast<std::uint32_t>(i);
+                             std::sort(keys.begin(), keys.end());
+
+                             std::int64_t pos = first;
+                             for (int i = 0; i < degree; ++i)
+                             {
+                                 int target = static_cast<int>(keys[i] >> 32);
+                                 if (i > 0 && target == static_cast<int>(keys[i - 1] >> 32))
+                                     continue;
+
+                                 targets[pos] = target;
+                                 weights[pos++] = rowWeights[static_cast<std::uint32_t>(keys[i])];
+                             }
+                             kept[u + 1] = pos - first;
+                         } });
+
+    for (int v = 0; v < V; ++v)
+        kept[v + 1] += kept[v];
+    if (kept[V] == offsets[V])
+        return CsrGraph(V, std::move(offsets), std::move(targets), std::move(weights));
+
+    std::vector<int> keptTargets(kept[V]);
+    std::vector<int> keptWeights(kept[V]);
+    pool.parallelFor(V, RowGrain, [&](int, int begin, int end)
+                     {
+                         for (int u = begin; u < end; ++u)
+                         {
+                             std::int64_t count = kept[u + 1] - kept[u];
+                             std::copy_n(targets.begin() + offsets[u], count, keptTargets.begin() + kept[u]);
+                             std::copy_n(weights.begin() + offsets[u], count, keptWeights.begin() + kept[u]);
+                         } });
+    return CsrGraph(V, std::move(kept), std::move(keptTargets), std::move(keptWeights));
+}
+
+// Complement of sorted adjacency rows.
+static std::vector<std::vector<int>> complementRows(const std::vector<std::vector<int>> &rows, ThreadPool &pool)
+{
+    int V = static_cast<int>(rows.size());
+    std::vector<std::vector<int>> complement(V);
+    pool.parallelFor(V, RowGrain, [&](int, int begin, int end)
+                     {
+                         for (int u = begin; u < end; ++u)
+                         {
+                             complement[u].reserve(V - 1 - rows[u].size());
+                             auto it = rows[u].begin();
+                             for (int v = 0; v < V; ++v)
+                             {
+                                 if (it != rows[u].end() && *it == v)
+                                     ++it;
+                                 else if (v != u)
+                                     complement[u].push_back(v);
+                             }
+                         } });
+    return complement;
+}
+
+CsrGraph randomCompleteGraph(int V, std::uint64_t seed, ThreadPool &pool, int minWeight, int maxWeight)
+{
+    if (V < 0)
+        throw std::invalid_argument("The number of vertices must be non-negative.");
+    checkWeights(minWeight, maxWeight);
+
+    std::int64_t degree = std::max(0, V - 1);
+    std::vector<std::int64_t> offsets(V + 1);
+    for (int u = 0; u <= V; ++u)
+        offsets[u] = u * degree;
+
+    std::vector<int> targets(offsets[V]);
+    std::vector<int> weights(offsets[V]);
+    pool.parallelFor(V, RowGrain, [&](int, int begin, int end)
+                     {
+                         for (int u = begin; u < end; ++u)
+                         {
+                             std::int64_t pos = offsets[u];
+                             for (int v = 0; v < V; ++v)
+                             {
+                                 if (v == u)
+                                     continue;
+
+                                 targets[pos] = v;
+                                 weights[pos++] = pairWeight(seed, u, v, minWeight, maxWeight);
+                             }
+                         } });
+
+    return CsrGraph(V, std::move(offsets), std::move(targets), std::move(weights));
+}
+
+CsrGraph randomDegreeGraph(int V, int KMin, int KMax, std::uint64_t seed, ThreadPool &pool, int minWeight, int maxWeight)
+{
+    if (V < 0)
+        throw std::invalid_argument("The number of vertices must be non-negative.");
+    if (KMin < 0 || KMax < KMin)
+        throw std::invalid_argument("Invalid edge constraints, all values must be non-negative and KMax >= KMin.");
+    if (V > 0 && KMin > V - 1)
+        throw std::invalid_argument("KMin must not exceed V - 1.");
+    checkWeights(minWeight, maxWeight);
+
+    KMax = std::min(KMax, std::max(0, V - 1));
+    std::uint64_t topology = seed ^ TopologySalt;
+
+    // Dense bounds are generated as the sparse complement, where the configuration model rarely repeats an edge.
+    bool complement = KMin + KMax > V - 1;
+    int low = complement ? V - 1 - KMax : KMin;
+    int high = complement ? V - 1 - KMin : KMax;
+
+    std::vector<int> degrees(V);
+    std::int64_t total = 0;
+    for (int v = 0; v < V; ++v)
+    {
+        degrees[v] = CounterRng(topology, v).uniformIntAt(0, low, high);
+        total += degrees[v];
+    }
+    // Stubs pair up only if their count is even; when every vertex sits at one bound there is no graph at all.
+    if (total % 2 != 0)
+    {
+        auto it = std::find_if(degrees.begin(), degrees.end(), [high](int d)
+                               { return d < high; });
+        if (it != degrees.end())
+            ++*it;
+        else if (low < high)
+            --degrees.front();
+        else
+            throw std::invalid_argument("No graph has every degree equal to an odd KMin with an odd number of vertices.");
+    }
+
+    std::vector<std::vector<int>> rows = matchStubs(degrees, topology, pool);
+    repairDegrees(rows, low, high, topology);
+    if (complement)
+        rows = complementRows(rows, pool);
+
+    return rowsToCsr(rows, seed, pool, minWeight, maxWeight);
+}
+
+CsrGraph randomPowerLawGraph(int V, double exponent, int minDegree, int maxDegree, std::uint64_t seed, ThreadPool &pool,
+                             int minWeight, int maxWeight)
+{
+    if (V < 0)
+        throw std::invalid_argument("The number of vertices must be non-negative.");
+    if (exponent <= 1)
+        throw std::invalid_argument("The power-law exponent must be greater than 1.");
+    if (minDegree < 1 || maxDegree < minDegree)
+        throw std::invalid_argument("Invalid degree bounds, minDegree must be positive and maxDegree >= minDegree.");
+    checkWeights(minWeight, maxWeight);
+
+    maxDegree = std::min(maxDegree, std::max(1, V - 1));
+    minDegree = std::min(minDegree, maxDegree);
+    std::uint64_t topology = seed ^ TopologySalt;
+
+    // Inverse transform of a Pareto distribution truncated to [minDegree, maxDegree].
+    std::vector<int> degrees(V);
+    std::int64_t total = 0;
+    for (int v = 0; v < V; ++v)
+    {
+        CounterRng rng(topology, v);
+        double u = rng.uniformReal();
+        double degree = minDegree * std::pow(1 - u, -1 / (exponent - 1));
+        degrees[v] = static_cast<int>(std::min<double>(maxDegree, degree));
+        total += degrees[v];
+    }
+    if (total % 2 != 0 && V > 0)
+        ++degrees[std::min_element(degrees.begin(), degrees.end()) - degrees.begin()];
+
+    return rowsToCsr(matchStubs(degrees, topology, pool), seed, pool, minWeight, maxWeight);
+}
+
+CsrGraph randomGeometricGraph(int V, double averageDegree, std::uint64_t seed, ThreadPool &pool, std::vector<City> *cities)
+{
+    if (V < 0)
+        throw std::invalid_argument("The number of vertices must be non-negative.");
+    if (averageDegree < 0)
+        throw std::invalid_argument("The average degree must be non-negative.");
+
+    std::uint64_t topology = seed ^ TopologySalt;
+    std::vector<int> xs(V);
+    std::vector<int> ys(V);
+    for (int v = 0; v < V; ++v)
+    {
+        CounterRng rng(topology, v);
+        xs[v] = rng.uniformIntAt(0, 0, GeometricSide - 1);
+        ys[v] = rng.uniformIntAt(1, 0, GeometricSide - 1);
+    }
+    if (cities)
+    {
+        cities->clear();
+        for (int v = 0; v < V; ++v)
+            cities->emplace_back(v, xs[v], ys[v]);
+    }
+
+    // A disc of this radius holds averageDegree other points on average; a square cell grid of the same width means
+    // every neighbour lies in the 3 x 3 cells around a point.
+    double radius = V > 1 ? GeometricSide * std::sqrt(averageDegree / (3.14159265358979323846 * (V - 1))) : 0;
+    std::int64_t squaredRadius = static_cast<std::int64_t>(radius * radius);
+    int cellsPerSide = std::max(1, std::min(static_cast<int>(GeometricSide / std::max(1.0, radius)), static_cast<int>(std::sqrt(V))));
+    double cellWidth = static_cast<double>(GeometricSide) / cellsPerSide;
+
+    auto cellOf = [&](int v)
+    {
+        int cx = std::min(cellsPerSide - 1, static_cast<int>(xs[v] / cellWidth));
+        int cy = std::min(cellsPerSide - 1, static_cast<int>(ys[v] / cellWidth));
+        return cy * cellsPerSide + cx;
+    };
+
+    int cellsCount = cellsPerSide * cellsPerSide;
+    std::vector<int> cellStart(cellsCount + 1, 0);
+    for (int v = 0; v < V; ++v)
+        ++cellStart[cellOf(v) + 1];
+    for (int c = 0; c < cellsCount; ++c)
+        cellStart[c + 1] += cellStart[c];
+    std::vector<int> members(V);
+    std::vector<int> fill(cellStart.begin(), cellStart.end() - 1);
+    for (int v = 0; v < V; ++v)
+        members[fill[cellOf(v)]++] = v;
+
+    std::vector<std::vector<int>> rows(V);
+    std::vector<std::vector<int>> lengths(V);
+    pool.parallelFor(V, RowGrain, [&](int, int begin, int end)
+                     {
+                         for (int u = begin; u < end; ++u)
+                         {
+                             int cell = cellOf(u);
+                             int cx = cell % cellsPerSide;
+                             int cy = cell / cellsPerSide;
+                             for (int y = std::max(0, cy - 1); y <= std::min(cellsPerSide - 1, cy + 1); ++y)
+                             {
+                                 for (int x = std::max(0, cx - 1); x <= std::min(cellsPerSide - 1, cx + 1); ++x)
+                                 {
+                                     int c = y * cellsPerSide + x;
+                                     for (int i = cellStart[c]; i < cellStart[c + 1]; ++i)
+                                     {
+                                         int v = members[i];
+                                         std::int64_t dx = xs[u] - xs[v];
+                                         std::int64_t dy = ys[u] - ys[v];
+                                         if (v != u && dx * dx + dy * dy <= squaredRadius)
+                                             rows[u].push_back(v);
+                                     }
+                                 }
+                             }
+                             std::sort(rows[u].begin(), rows[u].end());
+                         } });
+
+    // Weights are the truncated straight-line lengths, at least 1, as for Graph built from cities.
+    std::vector<std::int64_t> offsets(V + 1, 0);
+    for (int u = 0; u < V; ++u)
+        offsets[u + 1] = offsets[u] + static_cast<std::int64_t>(rows[u].size());
+    std::vector<int> targets(offsets[V]);
+    std::vector<int> weights(offsets[V]);
+    pool.parallelFor(V, RowGrain, [&](int, int begin, int end)
+                     {
+                         for (int u = begin; u < end; ++u)
+                         {
+                             std::int64_t pos = offsets[u];
+                             for (int v : rows[u])
+                             {
+                                 std::int64_t dx = xs[u] - xs[v];
+                                 std::int64_t dy = ys[u] - ys[v];
+                                 targets[pos] = v;
+                                 weights[pos++] = std::max(1, static_cast<int>(std::sqrt(static_cast<double>(dx * dx + dy * dy))));
+                             }
+                         } });
+
+    return CsrGraph(V, std::move(offsets), std::move(targets), std::move(weights));
+}
+
+CsrGraph gridGraph(int rows, int columns, std::uint64_t seed, ThreadPool &pool, int minWeight, int maxWeight)
+{
+    if (rows < 0 || columns < 0)
+        throw std::invalid_argument("The grid dimensions must be non-negative.");
+    if (static_cast<std::int64_t>(rows) * columns > std::numeric_limits<int>::max())
+        throw std::invalid_argument("The grid has too many vertices.");
+    checkWeights(minWeight, maxWeight);
+
+    int V = rows * columns;
+    std::vector<std::vector<int>> adjacency(V);
+    pool.parallelFor(V, RowGrain, [&](int, int begin, int end)
+                     {
+                         for (int v = begin; v < end; ++v)
+                         {
+                             int r = v / columns;
+                             int c = v % columns;
+                             // Ascending order: up, left, right, down.
+                             if (r > 0)
+                                 adjacency[v].push_back(v - columns);
+                             if (c > 0)
+                                 adjacency[v].push_back(v - 1);
+                             if (c + 1 < columns)
+                                 adjacency[v].push_back(v + 1);
+                             if (r + 1 < rows)
+                                 adjacency[v].push_back(v + columns);
+                         } });
+
+    return rowsToCsr(adjacency, seed, pool, minWeight, maxWeight);
+}
@@ -0,0 +1,43 @@
+#ifndef GRAPH_GENERATORS_H
+#define GRAPH_GENERATORS_H
+
+#include <vector>
+#include <cstdint>
+#include "Graph.h"
+#include "CsrGraph.h"
+#include "ThreadPool.h"
+
+// Random graph generators writing straight into a CSR snapshot instead of inserting edges into hash sets one by one.
+// Randomness comes from CounterRng streams keyed by vertex, so an explicit seed gives a bit-identical graph for any
+// number of threads. Edge weights are drawn uniformly from [minWeight, maxWeight].
+
+// Undirected CSR snapshot of an edge list. Self-loops are dropped and a repeated edge keeps its first weight, as with
+// Graph::addEdge.
+CsrGraph csrFromEdges(int V, const std::vector<Edge> &edges, ThreadPool &pool);
+
+// Complete graph; the weight of edge (u, v) is element max(u, v) of stream min(u, v), so rows fill in parallel.
+CsrGraph randomCompleteGraph(int V, std::uint64_t seed, ThreadPool &pool, int minWeight = 1, int maxWeight = 50);
+
+// Configuration model with degrees in [KMin, KMax]: every vertex draws a target degree, the shuffled degree stubs are
+// paired up in O(V + E), and the few vertices left below KMin by dropped loops and repeated edges are repaired with
+// local edge switches. KMax is clamped to V - 1. When KMin + KMax > V - 1 the sparser complement is generated instead.
+// Throws invalid_argument if KMin > V - 1 or no graph meets the bounds, runtime_error if the repair gives up.
+CsrGraph randomDegreeGraph(int V, int KMin, int KMax, std::uint64_t seed, ThreadPool &pool, int minWeight = 1, int maxWeight = 50);
+
+// Erased configuration model over a power-law degree sequence: P(degree = k) ~ k^-exponent on [minDegree, maxDegree],
+// like the hubs of social or web networks. Loops and repeated edges are dropped, so a few degrees end up lower.
+CsrGraph randomPowerLawGraph(int V, double exponent, int minDegree, int maxDegree, std::uint64_t seed, ThreadPool &pool,
+                             int minWeight = 1, int maxWeight = 50);
+
+// Side of the square the points of randomGeometricGraph are drawn from.
+constexpr int GeometricSide = 1 << 20;
+
+// Random geometric graph: uniform points on the GeometricSide square, joined when closer than the radius that gives
+// the requested average degree. Weights are the truncated distances, at least 1. If cities is not null, it receives
+// the coordinates, e.g. for A* or the TSP heuristics.
+CsrGraph randomGeometricGraph(int V, double averageDegree, std::uint64_t seed, ThreadPool &pool, std::vector<City> *cities = nullptr);
+
+// rows x columns lattice with four-neighbour connectivity; vertex r * columns + c sits at row r, column c.
+CsrGraph gridGraph(int rows, int columns, std::uint64_t seed, ThreadPool &pool, int minWeight = 1, int maxWeight = 50);
+
+#endif // GRAPH_GENERATORS_H
@@ -0,0 +1,63 @@
+#ifndef HILBERT_CURVE_H
+#define HILBERT_CURVE_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <utility>
+#include "Graph.h"
+
+// Position of the cell (x, y) along the Hilbert curve filling the 2^32 x 2^32 grid. Cells close on the curve are close
+// in the plane, so sorting points by this index groups neighbouring points together.
+inline std::uint64_t hilbertIndex(std::uint32_t x, std::uint32_t y)
+{
+    std::uint64_t index = 0;
+    for (std::uint32_t half = 1u << 31; half > 0; half >>= 1)
+    {
+        std::uint32_t right = (x & half) ? 1 : 0;
+        std::uint32_t up = (y & half) ? 1 : 0;
+        index += static_cast<std::uint64_t>(half) * half * ((3 * right) ^ up);
+
+        // Rotate the quadrant so the curve inside it starts and ends next to its neighbours.
+        if (up == 0)
+        {
+            if (right == 1)
+            {
+                x = ~x;
+                y = ~y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return index;
+}
+
+// Indices of the cities in the order the Hilbert curve visits them, ties broken by the lower index.
+// Coordinates are shifted by the bounding box minimum, so any int coordinates are exact.
+inline std::vector<int> hilbertOrder(const std::vector<City> &cities)
+{
+    int n = static_cast<int>(cities.size());
+    int minX = 0;
+    int minY = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        minX = i == 0 ? cities[i].x : std::min(minX, cities[i].x);
+        minY = i == 0 ? cities[i].y : std::min(minY, cities[i].y);
+    }
+
+    std::vector<std::pair<std::uint64_t, int>> keys(n);
+    for (int i = 0; i < n; ++i)
+    {
+        auto x = static_cast<std::uint32_t>(static_cast<std::int64_t>(cities[i].x) - minX);
+        auto y = static_cast<std::uint32_t>(static_cast<std::int64_t>(cities[i].y) - minY);
+        keys[i] = std::make_pair(hilbertIndex(x, y), i);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<int> order(n);
+    for (int i = 0; i < n; ++i)
+        order[i] = keys[i].second;
+    return order;
+}
+
+#endif // HILBERT_CURVE_H
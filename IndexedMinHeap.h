@@ -0,0 +1,181 @@
+#ifndef INDEXED_MIN_HEAP_H
+#define INDEXED_MIN_HEAP_H
+
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+// IndexedMinHeap is a d-ary min-heap over dense integer identifiers in [0, capacity).
+// Element positions are tracked in a flat array, so decreaseKey needs no hashing.
+template <typename TKey, int Arity = 4>
+class IndexedMinHeap
+{
+    static_assert(Arity >= 2, "Heap arity must be at least 2");
+
+private:
+    // Keys are stored next to their identifiers so sifting never leaves the heap array.
+    std::vector<std::pair<TKey, int>> heap;
+    std::vector<int> position;
+
+public:
+    static constexpr int NotInHeap = -1;
+
+    IndexedMinHeap(int capacity = 0) : position(capacity, NotInHeap) {}
+
+    // Builds the heap from keys[i] for every identifier i in linear time.
+    IndexedMinHeap(const std::vector<TKey> &keys) : position(keys.size())
+    {
+        heap.reserve(keys.size());
+        for (int i = 0; i < static_cast<int>(keys.size()); ++i)
+        {
+            heap.emplace_back(keys[i], i);
+            position[i] = i;
+        }
+
+        for (int i = size() / Arity; i >= 0 && size() > 1; --i)
+            siftDown(i);
+    }
+
+    int size() const { return static_cast<int>(heap.size()); }
+    int capacity() const { return static_cast<int>(position.size()); }
+    bool isEmpty() const { return heap.empty(); }
+    bool contains(int id) const { return position[id] != NotInHeap; }
+
+    const TKey &key(int id) const { return heap[position[id]].first; }
+
+    std::pair<TKey, int> minimum() const
+    {
+        if (isEmpty())
+            throw std::out_of_range("Heap is empty");
+        return heap.front();
+    }
+
+    void insert(int id, const TKey &key)
+    {
+        if (id < 0 || id >= capacity())
+            throw std::out_of_range("Identifier is outside of the heap capacity");
+        if (contains(id))
+            throw std::invalid_argument("Identifier is already in the heap");
+
+        heap.emplace_back(key, id);
+        position[id] = size() - 1;
+        siftUp(size() - 1);
+    }
+
+    // Returns the identifier with the smallest key together with that key.
+    std::pair<TKey, int> extractMin()
+    {
+        if (isEmpty())
+            throw std::out_of_range("Heap is empty");
+
+        std::pair<TKey, int> min = heap.front();
+        position[min.second] = NotInHeap;
+
+        if (size() > 1)
+        {
+            heap.front() = heap.back();
+            position[heap.front().second] = 0;
+            heap.pop_back();
+            siftDown(0);
+        }
+        else
+            heap.pop_back();
+
+        return min;
+    }
+
+    void decreaseKey(int id, const TKey &newKey)
+    {
+        int index = position[id];
+        if (index == NotInHeap)
+            throw std::invalid_argument("Identifier is not in the heap");
+        if (heap[index].first < newKey)
+            throw std::invalid_argument("New key is greater than current key");
+
+        heap[index].first = newKey;
+        siftUp(index);
+    }
+
+    // Inserts the identifier or lowers its key if it is already queued. Returns true on insertion.
+    bool insertOrDecrease(int id, const TKey &key)
+    {
+        if (!contains(id))
+        {
+            insert(id, key);
+            return true;
+        }
+
+        decreaseKey(id, key);
+        return false;
+    }
+
+    void clear()
+    {
+        for (const auto &entry : heap)
+            position[entry.second] = NotInHeap;
+        heap.clear();
+    }
+
+    friend std::ostream &operator<<(std::ostream &os, const IndexedMinHeap<TKey, Arity> &obj)
+    {
+        if (obj.isEmpty())
+            os << "<BLANK>" << std::endl;
+        for (const auto &entry : obj.heap)
+            os << entry.second << " (" << entry.first << ") ";
+        return os;
+    }
+
+private:
+    static int parent(int index) { return (index - 1) / Arity; }
+    static int firstChild(int index) { return index * Arity + 1; }
+
+    void siftUp(int index)
+    {
+        std::pair<TKey, int> entry = heap[index];
+        while (index > 0)
+        {
+            int p = parent(index);
+            if (!(entry.first < heap[p].first))
+                break;
+
+            heap[index] = heap[p];
+            position[heap[index].second] = index;
+            index = p;
+        }
+        heap[index] = entry;
+        position[entry.second] = index;
+    }
+
+    void siftDown(int index)
+    {
+        std::pair<TKey, int> entry = heap[index];
+        int count = size();
+        while (true)
+        {
+            int first = firstChild(index);
+            if (first >= count)
+                break;
+
+            int last = std::min(first + Arity, count);
+            int smallest = first;
+            for (int c = first + 1; c < last; ++c)
+            {
+                if (heap[c].first < heap[smallest].first)
+                    smallest = c;
+            }
+
+            if (!(heap[smallest].first < entry.first))
+                break;
+
+            heap[index] = heap[smallest];
+            position[heap[index].second] = index;
+            index = smallest;
+        }
+        heap[index] = entry;
+        position[entry.second] = index;
+    }
+};
+
+#endif // INDEXED_MIN_HEAP_H
@@ -0,0 +1,478 @@
+#include "InstanceFiles.h"
+#include "GraphGenerators.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+
+// Bytes read from the file at once. A line longer than this grows the buffer.
+static constexpr std::size_t ChunkSize = 1 << 22;
+
+// ChunkedLineReader hands out the lines of a text file as views into a reused buffer, which is only valid until the
+// next call. Line terminators (\n or \r\n) are not part of the line.
+class ChunkedLineReader
+{
+public:
+    explicit ChunkedLineReader(const std::string &path) : path(path), file(std::fopen(path.c_str(), "rb")), buffer(ChunkSize)
+    {
+        if (file == nullptr)
+            throw std::runtime_error("Could not open " + path + ".");
+    }
+
+    ~ChunkedLineReader() { std::fclose(file); }
+
+    ChunkedLineReader(const ChunkedLineReader &) = delete;
+    ChunkedLineReader &operator=(const ChunkedLineReader &) = delete;
+
+    bool next(std::string_view &line)
+    {
+        while (true)
+        {
+            const char *data = buffer.data();
+            const char *newline = static_cast<const char *>(std::memchr(data + position, '\n', filled - position));
+            if (newline != nullptr || (finished && position < filled))
+            {
+                const char *end = newline != nullptr ? newline : data + filled;
+                line = std::string_view(data + position, end - (data + position));
+                if (!line.empty() && line.back() == '\r')
+                    line.remove_suffix(1);
+                position = newline != nullptr ? newline - data + 1 : filled;
+                ++lineNumber;
+                return true;
+            }
+            if (finished)
+                return false;
+
+            // Keep the unfinished line at the front and fill the rest of the buffer behind it.
+            std::size_t tail = filled - position;
+            std::memmove(buffer.data(), data + position, tail);
+            filled = tail;
+            position = 0;
+            if (filled == buffer.size())
+                buffer.resize(2 * buffer.size());
+
+            std::size_t read = std::fread(buffer.data() + filled, 1, buffer.size() - filled, file);
+            if (std::ferror(file))
+                throw std::runtime_error("Could not read " + path + ".");
+            filled += read;
+            finished = read == 0;
+        }
+    }
+
+    [[noreturn]] void fail(const std::string &message) const
+    {
+        throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": " + message);
+    }
+
+private:
+    std::string path;
+    std::FILE *file;
+    std::vector<char> buffer;
+    std::size_t position = 0;
+    std::size_t filled = 0;
+    bool finished = false;
+    std::int64_t lineNumber = 0;
+};
+
+// FieldReader splits one line into whitespace-separated fields and parses numbers without locale or allocation.
+class FieldReader
+{
+public:
+    explicit FieldReader(std::string_view line) : current(line.data()), end(line.data() + line.size()) {}
+
+    bool atEnd()
+    {
+        skipSpaces();
+        return current == end;
+    }
+
+    std::string_view word()
+    {
+        skipSpaces();
+        const char *begin = current;
+        while (current != end && *current != ' ' && *current != '\t')
+            ++current;
+        return std::string_view(begin, current - begin);
+    }
+
+    // Reads the next field as a number; false if it is missing or is not one.
+    template <typename T>
+    bool number(T &value)
+    {
+        skipSpaces();
+        if (current != end && *current == '+')
+            ++current;
+        std::from_chars_result result = std::from_chars(current, end, value);
+        if (result.ec != std::errc() || (result.ptr != end && *result.ptr != ' ' && *result.ptr != '\t'))
+            return false;
+        current = result.ptr;
+        return true;
+    }
+
+private:
+    const char *current;
+    const char *end;
+
+    void skipSpaces()
+    {
+        while (current != end && (*current == ' ' || *current == '\t'))
+            ++current;
+    }
+};
+
+CsrGraph loadDimacsGraph(const std::string &path, ThreadPool &pool)
+{
+    ChunkedLineReader reader(path);
+    std::string_view line;
+    std::int64_t V = -1;
+    std::int64_t arcs = 0;
+    std::vector<Edge> edges;
+
+    while (reader.next(line))
+    {
+        FieldReader fields(line);
+        std::string_view kind = fields.word();
+        if (kind == "a")
+        {
+            if (V < 0)
+                reader.fail("Arc before the problem line.");
+
+            int u, v, weight;
+            if (!fields.number(u) || !fields.number(v) || !fields.number(weight))
+                reader.fail("Malformed arc.");
+            if (u < 1 || v < 1 || u > V || v > V)
+                reader.fail("Arc endpoint out of range.");
+            edges.emplace_back(u - 1, v - 1, weight);
+        }
+        else if (kind == "p")
+        {
+            if (fields.word() != "sp" || !fields.number(V) || !fields.number(arcs) || V < 0 || V > std::numeric_limits<int>::max() || arcs < 0)
+                reader.fail("Expected the problem line \"p sp <vertices> <arcs>\".");
+            edges.reserve(arcs);
+        }
+        else if (kind != "c" && !kind.empty())
+            reader.fail("Unknown line type.");
+    }
+
+    if (V < 0)
+        reader.fail("Missing the problem line.");
+    if (static_cast<std::int64_t>(edges.size()) != arcs)
+        reader.fail("Expected " + std::to_string(arcs) + " arcs, found " + std::to_string(edges.size()) + ".");
+
+    return csrFromEdges(static_cast<int>(V), edges, pool);
+}
+
+std::vector<City> loadDimacsCoordinates(const std::string &path)
+{
+    ChunkedLineReader reader(path);
+    std::string_view line;
+    std::int64_t V = -1;
+    std::vector<City> cities;
+    std::vector<bool> seen;
+
+    while (reader.next(line))
+    {
+        FieldReader fields(line);
+        std::string_view kind = fields.word();
+        if (kind == "v")
+        {
+            if (V < 0)
+                reader.fail("Coordinates before the problem line.");
+
+            int id, x, y;
+            if (!fields.number(id) || !fields.number(x) || !fields.number(y))
+                reader.fail("Malformed coordinates.");
+            if (id < 1 || id > V)
+                reader.fail("Vertex out of range.");
+            if (seen[id - 1])
+                reader.fail("Repeated vertex.");
+            seen[id - 1] = true;
+            cities[id - 1] = City(id - 1, x, y);
+        }
+        else if (kind == "p")
+        {
+            if (fields.word() != "aux" || fields.word() != "sp" || fields.word() != "co" || !fields.number(V) || V < 0 || V > std::numeric_limits<int>::max())
+                reader.fail("Expected the problem line \"p aux sp co <vertices>\".");
+            cities.assign(V, City(0, 0, 0));
+            seen.assign(V, false);
+            for (int v = 0; v < V; ++v)
+                cities[v].index = v;
+        }
+        else if (kind != "c" && !kind.empty())
+            reader.fail("Unknown line type.");
+    }
+
+    if (V < 0)
+        reader.fail("Missing the problem line.");
+    for (std::int64_t v = 0; v < V; ++v)
+    {
+        if (!seen[v])
+            reader.fail("Missing coordinates of vertex " + std::to_string(v + 1) + ".");
+    }
+
+    return cities;
+}
+
+// Splits a TSPLIB specification line "KEY : VALUE" (spaces around the colon optional) into its key and value.
+static std::pair<std::string_view, std::string_view> specification(std::string_view line)
+{
+    std::size_t colon = line.find(':');
+    std::string_view key = line.substr(0, colon);
+    std::string_view value = colon == std::string_view::npos ? std::string_view() : line.substr(colon + 1);
+
+    auto trim = [](std::string_view text)
+    {
+        std::size_t first = text.find_first_not_of(" \t");
+        if (first == std::string_view::npos)
+            return std::string_view();
+        std::size_t last = text.find_last_not_of(" \t");
+        return text.substr(first, last - first + 1);
+    };
+    return {trim(key), trim(value)};
+}
+
+// TSPLIB rounds to the nearest integer by adding one half and truncating.
+static int nint(double value)
+{
+    return static_cast<int>(value + 0.5);
+}
+
+// Earth radius of the GEO distance in kilometres.
+static constexpr double TsplibEarthRadius = 6378.388;
+
+// Latitude or longitude in radians of a TSPLIB DDD.MM coordinate (degrees and minutes).
+static double geographicalRadians(double coordinate)
+{
+    const double Pi = 3.141592;
+    double degrees = static_cast<int>(coordinate);
+    double minutes = coordinate - degrees;
+    return Pi * (degrees + 5.0 * minutes / 3.0) / 180.0;
+}
+
+// Planar coordinates of the heuristics' cities span [0, CitySide] along the longer side of the bounding box, which
+// keeps the rounding error far below any TSPLIB distance while tour lengths still fit in an int.
+static constexpr double CitySide = 1 << 20;
+
+// Rounded planar cities for the heuristics. GEO nodes are first projected to kilometres around their mean latitude.
+static std::vector<City> planarCities(const TsplibInstance &instance)
+{
+    int V = instance.dimension();
+    std::vector<double> xs(instance.xs);
+    std::vector<double> ys(instance.ys);
+    if (instance.metric == TsplibMetric::Geographical)
+    {
+        double meanLatitude = 0;
+        for (int v = 0; v < V; ++v)
+            meanLatitude += geographicalRadians(instance.xs[v]) / V;
+        for (int v = 0; v < V; ++v)
+        {
+            xs[v] = TsplibEarthRadius * geographicalRadians(instance.ys[v]) * std::cos(meanLatitude);
+            ys[v] = TsplibEarthRadius * geographicalRadians(instance.xs[v]);
+        }
+    }
+
+    std::vector<City> cities;
+    if (V == 0)
+        return cities;
+
+    auto [minX, maxX] = std::minmax_element(xs.begin(), xs.end());
+    auto [minY, maxY] = std::minmax_element(ys.begin(), ys.end());
+    double side = std::max(*maxX - *minX, *maxY - *minY);
+    double scale = side > 0 ? CitySide / side : 1;
+    cities.reserve(V);
+    for (int v = 0; v < V; ++v)
+        cities.emplace_back(v, static_cast<int>(std::lround((xs[v] - *minX) * scale)), static_cast<int>(std::lround((ys[v] - *minY) * scale)));
+    return cities;
+}
+
+TsplibInstance loadTsplibInstance(const std::string &path)
+{
+    ChunkedLineReader reader(path);
+    std::string_view line;
+    TsplibInstance instance;
+    std::int64_t dimension = -1;
+    bool metricGiven = false;
+
+    while (reader.next(line))
+    {
+        auto [key, value] = specification(line);
+        if (key == "EOF")
+            break;
+        if (key == "NAME")
+            instance.name = std::string(value);
+        else if (key == "TYPE")
+        {
+            if (value != "TSP")
+                reader.fail("Only symmetric TSP instances are supported.");
+        }
+        else if (key == "DIMENSION")
+        {
+            FieldReader fields(value);
+            if (!fields.number(dimension) || dimension < 0 || dimension > std::numeric_limits<int>::max())
+                reader.fail("Malformed dimension.");
+        }
+        else if (key == "EDGE_WEIGHT_TYPE")
+        {
+            if (value == "EUC_2D")
+                instance.metric = TsplibMetric::Euclidean;
+            else if (value == "CEIL_2D")
+                instance.metric = TsplibMetric::CeilEuclidean;
+            else if (value == "ATT")
+                instance.metric = TsplibMetric::Pseudoeuclidean;
+            else if (value == "GEO")
+                instance.metric = TsplibMetric::Geographical;
+            else
+                reader.fail("Unsupported edge weight type " + std::string(value) + ".");
+            metricGiven = true;
+        }
+        else if (key == "NODE_COORD_SECTION")
+        {
+            if (dimension < 0 || !metricGiven)
+                reader.fail("The dimension and edge weight type must precede the coordinates.");
+
+            instance.xs.assign(dimension, 0);
+            instance.ys.assign(dimension, 0);
+            std::vector<bool> seen(dimension, false);
+            for (std::int64_t read = 0; read < dimension; ++read)
+            {
+                if (!reader.next(line))
+                    reader.fail("Expected " + std::to_string(dimension) + " nodes, found " + std::to_string(read) + ".");
+
+                FieldReader fields(line);
+                std::int64_t id;
+                double x, y;
+                if (!fields.number(id) || !fields.number(x) || !fields.number(y))
+                    reader.fail("Malformed node.");
+                if (id < 1 || id > dimension || seen[id - 1])
+                    reader.fail("Node out of range or repeated.");
+                seen[id - 1] = true;
+                instance.xs[id - 1] = x;
+                instance.ys[id - 1] = y;
+            }
+        }
+        else if (key.size() > 8 && key.substr(key.size() - 8) == "_SECTION")
+            reader.fail("Unsupported section " + std::string(key) + ".");
+    }
+
+    if (instance.xs.empty() && dimension != 0)
+        reader.fail("Missing NODE_COORD_SECTION.");
+
+    instance.cities = planarCities(instance);
+    return instance;
+}
+
+std::vector<int> loadTsplibTour(const std::string &path)
+{
+    ChunkedLineReader reader(path);
+    std::string_view line;
+    std::vector<int> tour;
+    bool inSection = false;
+
+    while (reader.next(line))
+    {
+        if (!inSection)
+        {
+            std::string_view key = specification(line).first;
+            if (key == "EOF")
+                break;
+            inSection = key == "TOUR_SECTION";
+            continue;
+        }
+
+        FieldReader fields(line);
+        bool closed = false;
+        while (!fields.atEnd())
+        {
+            int node;
+            if (!fields.number(node))
+            {
+                if (fields.word() == "EOF")
+                {
+                    closed = true;
+                    break;
+                }
+                reader.fail("Malformed tour node.");
+            }
+            if (node == -1)
+            {
+                closed = true;
+                break;
+            }
+            if (node < 1)
+                reader.fail("Tour node out of range.");
+            tour.push_back(node - 1);
+        }
+        if (closed)
+            break;
+    }
+
+    if (tour.empty())
+        reader.fail("Missing TOUR_SECTION.");
+    tour.push_back(tour.front());
+    return tour;
+}
+
+int TsplibInstance::distance(int u, int v) const
+{
+    double dx = xs[u] - xs[v];
+    double dy = ys[u] - ys[v];
+    switch (metric)
+    {
+    case TsplibMetric::Euclidean:
+        return nint(std::sqrt(dx * dx + dy * dy));
+    case TsplibMetric::CeilEuclidean:
+        return static_cast<int>(std::ceil(std::sqrt(dx * dx + dy * dy)));
+    case TsplibMetric::Pseudoeuclidean:
+    {
+        double r = std::sqrt((dx * dx + dy * dy) / 10.0);
+        int t = nint(r);
+        return t < r ? t + 1 : t;
+    }
+    case TsplibMetric::Geographical:
+    {
+        double latitudeU = geographicalRadians(xs[u]);
+        double longitudeU = geographicalRadians(ys[u]);
+        double latitudeV = geographicalRadians(xs[v]);
+        double longitudeV = geographicalRadians(ys[v]);
+        double q1 = std::cos(longitudeU - longitudeV);
+        double q2 = std::cos(latitudeU - latitudeV);
+        double q3 = std::cos(latitudeU + latitudeV);
+        return static_cast<int>(TsplibEarthRadius * std::acos(0.5 * ((1.0 + q1) * q2 - (1.0 - q1) * q3)) + 1.0);
+    }
+    }
+    return 0;
+}
+
+std::int64_t TsplibInstance::tourLength(const std::vector<int> &tour) const
+{
+    std::size_t count = tour.size() > 1 && tour.front() == tour.back() ? tour.size() - 1 : tour.size();
+    if (static_cast<int>(count) != dimension())
+        throw std::invalid_argument("The tour must visit every node exactly once.");
+
+    std::vector<bool> visited(count, false);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        int vertex = tour[i];
+        if (vertex < 0 || vertex >= dimension() || visited[vertex])
+            throw std::invalid_argument("The tour must visit every node exactly once.");
+        visited[vertex] = true;
+    }
+
+    std::int64_t length = 0;
+    for (std::size_t i = 0; i < count; ++i)
+        length += distance(tour[i], tour[i + 1 == count ? 0 : i + 1]);
+    return length;
+}
+
+double optimalityGap(const TsplibInstance &instance, const std::vector<int> &tour, const std::vector<int> &optimalTour)
+{
+    std::int64_t optimal = instance.tourLength(optimalTour);
+    if (optimal == 0)
+        throw std::invalid_argument("The optimal tour has zero length.");
+
+    return static_cast<double>(instance.tourLength(tour) - optimal) / optimal;
+}
@@ -0,0 +1,63 @@
+#ifndef INSTANCE_FILES_H
+#define INSTANCE_FILES_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "Graph.h"
+#include "CsrGraph.h"
+#include "ThreadPool.h"
+
+// Loaders for standard benchmark instances. Files are read in large chunks and parsed in place, line by line, without
+// per-line allocations. Malformed input throws runtime_error naming the file and line.
+
+// DIMACS 9th challenge shortest-path graph (.gr): "p sp n m" followed by m arcs "a u v w" with 1-based vertices.
+// Vertex i becomes vertex i - 1. The graph is undirected, so an arc and its reverse form one edge, which keeps the
+// weight of the first of them in the file.
+CsrGraph loadDimacsGraph(const std::string &path, ThreadPool &pool);
+
+// DIMACS coordinates (.co): "p aux sp co n" followed by n lines "v id x y". City i - 1 holds the coordinates of id i.
+std::vector<City> loadDimacsCoordinates(const std::string &path);
+
+// Distance functions of TSPLIB, which round differently from the truncated weights of EuclideanGraph.
+enum class TsplibMetric
+{
+    Euclidean,
+    CeilEuclidean,
+    Pseudoeuclidean,
+    Geographical
+};
+
+// Symmetric TSPLIB instance given by node coordinates (.tsp with EUC_2D, CEIL_2D, ATT or GEO weights).
+struct TsplibInstance
+{
+    std::string name;
+    TsplibMetric metric = TsplibMetric::Euclidean;
+    // Exact coordinates of node i + 1 at index i, as used by the metric.
+    std::vector<double> xs;
+    std::vector<double> ys;
+    // Integer coordinates for the heuristics over EuclideanGraph: shifted and scaled so the longer side of the bounding
+    // box spans 2^20, with GEO nodes first projected equirectangularly to kilometres around their mean latitude.
+    // The heuristics therefore optimize truncated, scaled planar distances. Those order tours almost like the instance
+    // metric, but not exactly: the nint/ceil rounding of TSPLIB and, for GEO, the spherical distance differ. Score
+    // tours with tourLength, never with the EuclideanGraph weights.
+    std::vector<City> cities;
+
+    int dimension() const { return static_cast<int>(xs.size()); }
+    // Distance between two nodes (0-based) under the instance metric.
+    int distance(int u, int v) const;
+    // Length of a closed tour (first vertex repeated at the end) or an open one under the instance metric.
+    // Throws invalid_argument if the tour is not a permutation of the nodes.
+    std::int64_t tourLength(const std::vector<int> &tour) const;
+};
+
+TsplibInstance loadTsplibInstance(const std::string &path);
+
+// TSPLIB tour (.tour): the 1-based nodes of TOUR_SECTION up to -1, returned 0-based and closed like the TSP heuristics'
+// tours.
+std::vector<int> loadTsplibTour(const std::string &path);
+
+// Relative excess of a tour over the optimal one, (length - optimal) / optimal, both measured by the instance metric.
+double optimalityGap(const TsplibInstance &instance, const std::vector<int> &tour, const std::vector<int> &optimalTour);
+
+#endif // INSTANCE_FILES_H
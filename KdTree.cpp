@@ -0,0 +1,286 @@
+#include "KdTree.h"
+#include <algorithm>
+#include <limits>
+
+// Depth of the tree is at most log2 of the point count, so a fixed stack covers any int-sized input.
+static constexpr int MaxStackDepth = 64;
+
+KdTree::KdTree(const EuclideanGraph &graph)
+    : order(graph.verticesCount()), xs(graph.verticesCount()), ys(graph.verticesCount()), slot(graph.verticesCount()),
+      leafOf(graph.verticesCount()), removed(graph.verticesCount(), false)
+{
+    for (int v = 0; v < size(); ++v)
+    {
+        order[v] = v;
+        xs[v] = graph.x(v);
+        ys[v] = graph.y(v);
+    }
+
+    if (size() > 0)
+        build(0, size(), -1);
+
+    // Coordinates move into tree order so leaf scans read consecutive memory.
+    std::vector<int> sortedXs(size());
+    std::vector<int> sortedYs(size());
+    for (int position = 0; position < size(); ++position)
+    {
+        sortedXs[position] = xs[order[position]];
+        sortedYs[position] = ys[order[position]];
+        slot[order[position]] = position;
+    }
+    xs.swap(sortedXs);
+    ys.swap(sortedYs);
+}
+
+int KdTree::build(int begin, int end, int parent)
+{
+    int index = static_cast<int>(nodes.size());
+    nodes.push_back({begin, end, -1, -1, parent, end - begin, -1,
+                     std::numeric_limits<int>::max(), std::numeric_limits<int>::min(),
+                     std::numeric_limits<int>::max(), std::numeric_limits<int>::min()});
+
+    for (int position = begin; position < end; ++position)
+    {
+        int v = order[position];
+        nodes[index].minX = std::min(nodes[index].minX, xs[v]);
+        nodes[index].maxX = std::max(nodes[index].maxX, xs[v]);
+        nodes[index].minY = std::min(nodes[index].minY, ys[v]);
+        nodes[index].maxY = std::max(nodes[index].maxY, ys[v]);
+    }
+
+    if (end - begin <= LeafSize)
+    {
+        for (int position = begin; position < end; ++position)
+            leafOf[order[position]] = index;
+        return index;
+    }
+
+    // Split the wider side of the bounding box at the median.
+    const std::vector<int> &coordinates =
+        static_cast<std::int64_t>(nodes[index].maxX) - nodes[index].minX >= static_cast<std::int64_t>(nodes[index].maxY) - nodes[index].minY ? xs : ys;
+    int middle = begin + (end - begin) / 2;
+    std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end, [&coordinates](int a, int b)
+                     { return coordinates[a] < coordinates[b]; });
+
+    int left = build(begin, middle, index);
+    int right = build(middle, end, index);
+    nodes[index].left = left;
+    nodes[index].right = right;
+    return index;
+}
+
+std::int64_t KdTree::squaredDistance(int position, int x, int y) const
+{
+    std::int64_t dx = static_cast<std::int64_t>(xs[position]) - x;
+    std::int64_t dy = static_cast<std::int64_t>(ys[position]) - y;
+    return dx * dx + dy * dy;
+}
+
+std::int64_t KdTree::boxDistance(const Node &node, int x, int y)
+{
+    std::int64_t dx = 0;
+    if (x < node.minX)
+        dx = static_cast<std::int64_t>(node.minX) - x;
+    else if (x > node.maxX)
+        dx = static_cast<std::int64_t>(x) - node.maxX;
+
+    std::int64_t dy = 0;
+    if (y < node.minY)
+        dy = static_cast<std::int64_t>(node.minY) - y;
+    else if (y > node.maxY)
+        dy = static_cast<std::int64_t>(y) - node.maxY;
+
+    return dx * dx + dy * dy;
+}
+
+void KdTree::remove(int vertex)
+{
+    if (removed[slot[vertex]])
+        return;
+
+    removed[slot[vertex]] = true;
+    for (int node = leafOf[vertex]; node != -1; node = nodes[node].parent)
+        --nodes[node].alive;
+}
+
+int KdTree::nearest(int vertex) const
+{
+    if (aliveCount() == 0)
+        return -1;
+
+    int x = xs[slot[vertex]];
+    int y = ys[slot[vertex]];
+    std::int64_t bestDistance = std::numeric_limits<std::int64_t>::max();
+    int best = -1;
+
+    int stack[MaxStackDepth];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0)
+    {
+        const Node &node = nodes[stack[--top]];
+        if (node.alive == 0 || boxDistance(node, x, y) > bestDistance)
+            continue;
+
+        if (node.left == -1)
+        {
+            for (int position = node.begin; position < node.end; ++position)
+            {
+                int candidate = order[position];
+                if (removed[position] || candidate == vertex)
+                    continue;
+
+                std::int64_t distance = squaredDistance(position, x, y);
+                if (distance < bestDistance || (distance == bestDistance && candidate < best))
+                {
+                    bestDistance = distance;
+                    best = candidate;
+                }
+            }
+            continue;
+        }
+
+        // The closer child is pushed last so it is searched first and tightens the bound early.
+        int nearChild = node.left;
+        int farChild = node.right;
+        if (boxDistance(nodes[farChild], x, y) < boxDistance(nodes[nearChild], x, y))
+            std::swap(nearChild, farChild);
+        stack[top++] = farChild;
+        stack[top++] = nearChild;
+    }
+
+    return best;
+}
+
+void KdTree::setLabels(const std::vector<int> &vertexLabels)
+{
+    labels.resize(size());
+    for (int position = 0; position < size(); ++position)
+        labels[position] = vertexLabels[order[position]];
+
+    // Children always follow their parent in the node array, so a backward pass sees them first.
+    for (int index = static_cast<int>(nodes.size()) - 1; index >= 0; --index)
+    {
+        Node &node = nodes[index];
+        if (node.left == -1)
+        {
+            node.label = labels[node.begin];
+            for (int position = node.begin + 1; position < node.end && node.label != -1; ++position)
+            {
+                if (labels[position] != node.label)
+                    node.label = -1;
+            }
+        }
+        else
+            node.label = nodes[node.left].label == nodes[node.right].label ? nodes[node.left].label : -1;
+    }
+}
+
+std::pair<std::int64_t, int> KdTree::nearestWithOtherLabel(int vertex, std::int64_t bound) const
+{
+    int position = slot[vertex];
+    int x = xs[position];
+    int y = ys[position];
+    int label = labels[position];
+    std::pair<std::int64_t, int> best(bound, -1);
+
+    int stack[MaxStackDepth];
+    int top = 0;
+    if (!nodes.empty())
+        stack[top++] = 0;
+    while (top > 0)
+    {
+        const Node &node = nodes[stack[--top]];
+        if (node.label == label || boxDistance(node, x, y) > best.first)
+            continue;
+
+        if (node.left == -1)
+        {
+            for (int other = node.begin; other < node.end; ++other)
+            {
+                if (labels[other] == label)
+                    continue;
+
+                std::pair<std::int64_t, int> candidate(squaredDistance(other, x, y), order[other]);
+                if (candidate.first < best.first || (candidate.first == best.first && (best.second == -1 || candidate.second < best.second)))
+                    best = candidate;
+            }
+            continue;
+        }
+
+        int nearChild = node.left;
+        int farChild = node.right;
+        if (boxDistance(nodes[farChild], x, y) < boxDistance(nodes[nearChild], x, y))
+            std::swap(nearChild, farChild);
+        stack[top++] = farChild;
+        stack[top++] = nearChild;
+    }
+
+    return best;
+}
+
+std::vector<int> KdTree::nearestNeighborLists(int k) const
+{
+    k = std::max(0, std::min(k, size() - 1));
+    std::vector<int> lists(static_cast<std::size_t>(size()) * k);
+    if (k == 0)
+        return lists;
+
+    // Max-heap of the k best candidates found so far, ordered by distance and then index.
+    std::vector<std::pair<std::int64_t, int>> best;
+    best.reserve(k + 1);
+    int stack[MaxStackDepth];
+
+    for (int position = 0; position < size(); ++position)
+    {
+        int vertex = order[position];
+        int x = xs[position];
+        int y = ys[position];
+        best.clear();
+
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0)
+        {
+            const Node &node = nodes[stack[--top]];
+            if (static_cast<int>(best.size()) == k && boxDistance(node, x, y) > best.front().first)
+                continue;
+
+            if (node.left == -1)
+            {
+                for (int other = node.begin; other < node.end; ++other)
+                {
+                    if (other == position)
+                        continue;
+
+                    std::pair<std::int64_t, int> candidate(squaredDistance(other, x, y), order[other]);
+                    if (static_cast<int>(best.size()) < k)
+                    {
+                        best.push_back(candidate);
+                        std::push_heap(best.begin(), best.end());
+                    }
+                    else if (candidate < best.front())
+                    {
+                        std::pop_heap(best.begin(), best.end());
+                        best.back() = candidate;
+                        std::push_heap(best.begin(), best.end());
+                    }
+                }
+                continue;
+            }
+
+            int nearChild = node.left;
+            int farChild = node.right;
+            if (boxDistance(nodes[farChild], x, y) < boxDistance(nodes[nearChild], x, y))
+                std::swap(nearChild, farChild);
+            stack[top++] = farChild;
+            stack[top++] = nearChild;
+        }
+
+        std::sort_heap(best.begin(), best.end());
+        for (int i = 0; i < k; ++i)
+            lists[static_cast<std::size_t>(vertex) * k + i] = best[i].second;
+    }
+
+    return lists;
+}
@@ -0,0 +1,77 @@
+#ifndef KD_TREE_H
+#define KD_TREE_H
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include "EuclideanGraph.h"
+
+// KdTree is a static 2-d tree over the vertices of a EuclideanGraph. Points are reordered so every node covers a
+// contiguous range, and each node keeps its bounding box and the number of points not yet removed.
+// Removal only marks points, so nearest queries skip exhausted subtrees and stay logarithmic on average
+// while a tour construction deletes the visited cities one by one.
+class KdTree
+{
+public:
+    // Points per leaf; small leaves are scanned linearly, which is faster than splitting further.
+    static constexpr int LeafSize = 8;
+
+    explicit KdTree(const EuclideanGraph &graph);
+
+    int size() const { return static_cast<int>(order.size()); }
+    int aliveCount() const { return nodes.empty() ? 0 : nodes[0].alive; }
+    // Vertex at a position in tree order; consecutive positions are spatially close.
+    int at(int position) const { return order[position]; }
+    bool contains(int vertex) const { return !removed[slot[vertex]]; }
+
+    // Removes the vertex from later nearest queries. Removing it twice has no effect.
+    void remove(int vertex);
+
+    // Closest vertex still in the tree other than the given one, ties broken by the lower index. -1 if none is left.
+    int nearest(int vertex) const;
+
+    // Assigns a label to every vertex (for example its component) for nearestWithOtherLabel.
+    void setLabels(const std::vector<int> &labels);
+
+    // Closest vertex whose label differs from the given vertex's label, as (squared distance, vertex), ties broken by
+    // the lower index. Removals are ignored. Only vertices within squared distance bound are considered; if there is
+    // none, the result is (bound, -1).
+    std::pair<std::int64_t, int> nearestWithOtherLabel(int vertex, std::int64_t bound) const;
+
+    // Candidate lists of the k closest vertices of every vertex, removals ignored, stored row-major with
+    // k entries per vertex in increasing distance. k is clamped to size() - 1.
+    std::vector<int> nearestNeighborLists(int k) const;
+
+private:
+    struct Node
+    {
+        int begin;
+        int end;
+        // Children indices, -1 for leaves.
+        int left;
+        int right;
+        int parent;
+        int alive;
+        // Label shared by all points of the node, or -1 if they differ.
+        int label;
+        int minX, maxX, minY, maxY;
+    };
+
+    std::vector<Node> nodes;
+    // Vertex stored at each tree position and the coordinates in the same order.
+    std::vector<int> order;
+    std::vector<int> xs;
+    std::vector<int> ys;
+    // Tree position and leaf node of every vertex.
+    std::vector<int> slot;
+    std::vector<int> leafOf;
+    std::vector<bool> removed;
+    // Labels in tree order.
+    std::vector<int> labels;
+
+    int build(int begin, int end, int parent);
+    std::int64_t squaredDistance(int position, int x, int y) const;
+    static std::int64_t boxDistance(const Node &node, int x, int y);
+};
+
+#endif // KD_TREE_H
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <vector>
 #include <functional>
+#include <stdexcept>
 #include <unordered_map>
 
 template <typename T, typename THash = std::hash<T>, typename TEquals = std::equal_to<T>>
@@ -0,0 +1,223 @@
+#include "MinimumSpanningForest.h"
+#include "UnionFind.h"
+#include "TspHeuristics.h"
+#include <algorithm>
+#include <atomic>
+
+using Link = SpanningForest::Link;
+
+// Vertices per parallel chunk.
+static constexpr int VertexGrain = 1024;
+// Edges per parallel chunk of the filter step.
+static constexpr int EdgeGrain = 1 << 14;
+// Edge counts up to which filter-Kruskal sorts instead of splitting further.
+static constexpr int KruskalThreshold = 1 << 12;
+
+static Link makeLink(int a, int b, int weight)
+{
+    return a < b ? Link{a, b, weight} : Link{b, a, weight};
+}
+
+SpanningForest primMSF(const CsrGraph &graph)
+{
+    int V = graph.verticesCount();
+    std::vector<Link> links;
+    if (V == 0)
+        return SpanningForest(V, std::move(links));
+
+    // primMST moves on to an unreached vertex once a component is exhausted; those vertices keep parent -1.
+    for (const VertexInfo &info : primMST(graph, 0))
+    {
+        if (info.parent != -1)
+            links.push_back(makeLink(info.vertex, info.parent, info.distance));
+    }
+
+    std::sort(links.begin(), links.end());
+    return SpanningForest(V, std::move(links));
+}
+
+SpanningForest boruvkaMSF(const CsrGraph &graph, ThreadPool &pool)
+{
+    int V = graph.verticesCount();
+    ConcurrentUnionFind components(V);
+    std::vector<int> labels(V);
+    // Lightest edge from each vertex to another component, as its other endpoint, or -1.
+    std::vector<int> lightest(V, -1);
+    std::vector<int> lightestWeight(V, 0);
+    // Vertex holding the lightest edge out of each component, indexed by the component's representative.
+    std::vector<std::atomic<int>> componentLightest(V);
+    std::vector<char> exhausted(V, 0);
+    std::vector<std::vector<Link>> found(pool.size());
+
+    auto linkOf = [&](int v)
+    { return makeLink(v, lightest[v], lightestWeight[v]); };
+
+    while (true)
+    {
+        pool.parallelFor(V, VertexGrain, [&](int, int begin, int end)
+                         {
+                             for (int v = begin; v < end; ++v)
+                             {
+                                 labels[v] = components.find(v);
+                                 componentLightest[v].store(-1, std::memory_order_relaxed);
+                             } });
+
+        std::atomic<bool> merging{false};
+        pool.parallelFor(V, VertexGrain, [&](int, int begin, int end)
+                         {
+                             bool any = false;
+                             for (int v = begin; v < end; ++v)
+                             {
+                                 lightest[v] = -1;
+                                 if (exhausted[v])
+                                     continue;
+
+                                 Link best{0, 0, 0};
+                                 for (const Arc &arc : graph.neighbors(v))
+                                 {
+                                     if (labels[arc.dest] == labels[v])
+                                         continue;
+
+                                     Link candidate = makeLink(v, arc.dest, arc.weight);
+                                     if (lightest[v] == -1 || candidate < best)
+                                     {
+                                         best = candidate;
+                                         lightest[v] = arc.dest;
+                                         lightestWeight[v] = arc.weight;
+                                     }
+                                 }
+
+                                 // Components only grow, so a vertex without outside edges never gets one back.
+                                 if (lightest[v] == -1)
+                                 {
+                                     exhausted[v] = 1;
+                                     continue;
+                                 }
+
+                                 any = true;
+                                 std::atomic<int> &slot = componentLightest[labels[v]];
+                                 // Release and acquire publish the holder's lightest edge together with its index.
+                                 int current = slot.load(std::memory_order_acquire);
+                                 while (current == -1 || best < linkOf(current))
+                                 {
+                                     if (slot.compare_exchange_weak(current, v, std::memory_order_release, std::memory_order_acquire))
+                                         break;
+                                 }
+                             }
+                             if (any)
+                                 merging.store(true, std::memory_order_relaxed); });
+
+        if (!merging.load())
+            break;
+
+        // Each chosen edge is the lightest leaving its component under a strict order, so together they form a
+        // forest; an edge chosen from both of its sides is kept once because only one unite succeeds.
+        pool.parallelFor(V, VertexGrain, [&](int worker, int begin, int end)
+                         {
+                             for (int v = begin; v < end; ++v)
+                             {
+                                 if (labels[v] != v)
+                                     continue;
+
+                                 int holder = componentLightest[v].load(std::memory_order_acquire);
+                                 if (holder != -1 && components.unite(holder, lightest[holder]))
+                                     found[worker].push_back(linkOf(holder));
+                             } });
+    }
+
+    std::vector<Link> links;
+    links.reserve(V);
+    for (const auto &part : found)
+        links.insert(links.end(), part.begin(), part.end());
+    std::sort(links.begin(), links.end());
+    return SpanningForest(V, std::move(links));
+}
+
+// Kruskal on a small range: sort and join in increasing order.
+static void kruskal(std::vector<Link>::iterator begin, std::vector<Link>::iterator end, ConcurrentUnionFind &components,
+                    std::vector<Link> &links)
+{
+    std::sort(begin, end);
+    for (auto it = begin; it != end; ++it)
+    {
+        if (components.unite(it->u, it->v))
+            links.push_back(*it);
+    }
+}
+
+static void filterKruskal(std::vector<Link>::iterator begin, std::vector<Link>::iterator end,
+                          ConcurrentUnionFind &components, std::vector<Link> &links, ThreadPool &pool)
+{
+    while (end - begin > KruskalThreshold)
+    {
+        // Median of three samples; keys are distinct, so both sides of the split are non-empty.
+        Link samples[3] = {*begin, *(begin + (end - begin) / 2), *(end - 1)};
+        std::sort(samples, samples + 3);
+        Link pivot = samples[1];
+
+        auto middle = std::partition(begin, end, [&pivot](const Link &link)
+                                     { return !(pivot < link); });
+        filterKruskal(begin, middle, components, links, pool);
+
+        // The light half is solved and no unite runs until the filter is done. Finds still halve paths, but with
+        // compare-and-swap, so they stay safe to run on all workers at once.
+        int count = static_cast<int>(end - middle);
+        std::vector<char> keep(count);
+        pool.parallelFor(count, EdgeGrain, [&](int, int first, int last)
+                         {
+                             for (int i = first; i < last; ++i)
+                             {
+                                 const Link &link = *(middle + i);
+                                 keep[i] = components.find(link.u) != components.find(link.v);
+                             } });
+
+        auto write = middle;
+        for (int i = 0; i < count; ++i)
+        {
+            if (keep[i])
+                *write++ = *(middle + i);
+        }
+        begin = middle;
+        end = write;
+    }
+
+    kruskal(begin, end, components, links);
+}
+
+SpanningForest filterKruskalMSF(const CsrGraph &graph, ThreadPool &pool)
+{
+    int V = graph.verticesCount();
+
+    // Each undirected edge once, from its lower endpoint. Rows are sorted, so the upper arcs of u follow u itself.
+    std::vector<std::int64_t> offsets(V + 1, 0);
+    pool.parallelFor(V, VertexGrain, [&](int, int begin, int end)
+                     {
+                         for (int u = begin; u < end; ++u)
+                         {
+                             int upper = 0;
+                             for (const Arc &arc : graph.neighbors(u))
+                                 upper += arc.dest > u;
+                             offsets[u + 1] = upper;
+                         } });
+    for (int u = 0; u < V; ++u)
+        offsets[u + 1] += offsets[u];
+
+    std::vector<Link> edges(offsets[V]);
+    pool.parallelFor(V, VertexGrain, [&](int, int begin, int end)
+                     {
+                         for (int u = begin; u < end; ++u)
+                         {
+                             std::int64_t slot = offsets[u];
+                             for (const Arc &arc : graph.neighbors(u))
+                             {
+                                 if (arc.dest > u)
+                                     edges[slot++] = Link{u, arc.dest, arc.weight};
+                             }
+                         } });
+
+    ConcurrentUnionFind components(V);
+    std::vector<Link> links;
+    links.reserve(V);
+    filterKruskal(edges.begin(), edges.end(), components, links, pool);
+    return SpanningForest(V, std::move(links));
+}
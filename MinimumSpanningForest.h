@@ -0,0 +1,25 @@
+#ifndef MINIMUM_SPANNING_FOREST_H
+#define MINIMUM_SPANNING_FOREST_H
+
+#include "CsrGraph.h"
+#include "ThreadPool.h"
+#include "SpanningForest.h"
+
+// Minimum spanning forest engines over a CSR snapshot. The graph may be sparse or disconnected; each engine returns a
+// minimum spanning tree of every component. Edges are compared by weight and then by their endpoints, so Borůvka and
+// filter-Kruskal return exactly the same forest for any thread count.
+
+// Prim's algorithm restarted in every component, sequential.
+SpanningForest primMSF(const CsrGraph &graph);
+
+// Parallel Borůvka: every round, each vertex finds its lightest edge leaving its component, each component keeps the
+// lightest of those, and all components join along them at once. Vertices with no edge leaving their component are
+// never scanned again. At most log2(V) rounds.
+SpanningForest boruvkaMSF(const CsrGraph &graph, ThreadPool &pool);
+
+// Filter-Kruskal: edges are split around a pivot weight, the light half is solved first, and heavy edges whose
+// endpoints it already connects are filtered out in parallel before the heavy half is sorted.
+// Most heavy edges of a dense graph never get sorted.
+SpanningForest filterKruskalMSF(const CsrGraph &graph, ThreadPool &pool);
+
+#endif // MINIMUM_SPANNING_FOREST_H
@@ -0,0 +1,72 @@
+#ifndef RADIX_HEAP_H
+#define RADIX_HEAP_H
+
+#include <vector>
+#include <utility>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+// RadixHeap is a monotone priority queue for non-negative integer keys.
+// Keys pushed must not be smaller than the last extracted key. Entries are bucketed by the highest bit
+// in which they differ from the last extracted key, so each entry is moved at most 32 times overall.
+// Stale entries are not removed on decrease, callers skip them when they are extracted.
+class RadixHeap
+{
+private:
+    static constexpr int BucketsCount = std::numeric_limits<unsigned>::digits + 1;
+
+    std::vector<std::pair<unsigned, int>> buckets[BucketsCount];
+    unsigned last;
+    int count;
+
+    static int bucketIndex(unsigned key, unsigned last)
+    {
+        return key == last ? 0 : std::numeric_limits<unsigned>::digits - __builtin_clz(key ^ last);
+    }
+
+public:
+    RadixHeap() : last(0), count(0) {}
+
+    bool isEmpty() const { return count == 0; }
+    int size() const { return count; }
+
+    void push(int key, int id)
+    {
+        if (key < 0 || static_cast<unsigned>(key) < last)
+            throw std::invalid_argument("Key is smaller than the last extracted key");
+
+        buckets[bucketIndex(key, last)].emplace_back(key, id);
+        ++count;
+    }
+
+    // Returns the identifier with the smallest key together with that key.
+    std::pair<int, int> extractMin()
+    {
+        if (count == 0)
+            throw std::out_of_range("Heap is empty");
+
+        if (buckets[0].empty())
+        {
+            int i = 1;
+            while (buckets[i].empty())
+                ++i;
+
+            unsigned newLast = buckets[i].front().first;
+            for (const auto &entry : buckets[i])
+                newLast = std::min(newLast, entry.first);
+
+            last = newLast;
+            for (const auto &entry : buckets[i])
+                buckets[bucketIndex(entry.first, last)].push_back(entry);
+            buckets[i].clear();
+        }
+
+        auto entry = buckets[0].back();
+        buckets[0].pop_back();
+        --count;
+        return std::make_pair(static_cast<int>(entry.first), entry.second);
+    }
+};
+
+#endif // RADIX_HEAP_H
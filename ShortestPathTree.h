@@ -0,0 +1,82 @@
+#ifndef SHORTEST_PATH_TREE_H
+#define SHORTEST_PATH_TREE_H
+
+#include <vector>
+#include <limits>
+#include <iostream>
+#include <algorithm>
+
+// ShortestPathTree holds single-source shortest path results as flat arrays indexed by vertex.
+// Paths are not stored, they are reconstructed from the parent array on request.
+class ShortestPathTree
+{
+public:
+    static constexpr int Unreachable = std::numeric_limits<int>::max() / 2;
+
+    int source;
+    std::vector<int> distances;
+    std::vector<int> parents;
+    // Whether the vertex's distance is final; false for unreachable vertices and those left behind by an early stop.
+    std::vector<bool> settled;
+
+    ShortestPathTree(int source, int V) : source(source), distances(V, Unreachable), parents(V, -1), settled(V, false)
+    {
+        distances[source] = 0;
+    }
+
+    int verticesCount() const { return static_cast<int>(distances.size()); }
+    bool isReachable(int vertex) const { return distances[vertex] != Unreachable; }
+
+    // Vertices from the source to the given vertex, or an empty path if the vertex was not reached.
+    std::vector<int> path(int vertex) const
+    {
+        std::vector<int> result;
+        appendPath(vertex, result);
+        return result;
+    }
+
+    // Streams every vertex with its distance and path, reusing a single path buffer.
+    void print(std::ostream &os) const
+    {
+        std::vector<int> buffer;
+        for (int vertex = 0; vertex < verticesCount(); ++vertex)
+        {
+            os << "Vertex: " << vertex << ", distance: " << distances[vertex] << ", path: ";
+            buffer.clear();
+            if (!appendPath(vertex, buffer))
+            {
+                os << "No path exists" << std::endl;
+                continue;
+            }
+
+            for (std::size_t i = 0; i < buffer.size(); ++i)
+            {
+                os << buffer[i];
+                if (i + 1 < buffer.size())
+                    os << " -> ";
+            }
+            os << std::endl;
+        }
+    }
+
+    friend std::ostream &operator<<(std::ostream &os, const ShortestPathTree &obj)
+    {
+        obj.print(os);
+        return os;
+    }
+
+private:
+    bool appendPath(int vertex, std::vector<int> &out) const
+    {
+        if (!isReachable(vertex))
+            return false;
+
+        std::size_t first = out.size();
+        for (int current = vertex; current != -1; current = parents[current])
+            out.push_back(current);
+        std::reverse(out.begin() + first, out.end());
+        return true;
+    }
+};
+
+#endif // SHORTEST_PATH_TREE_H
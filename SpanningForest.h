@@ -0,0 +1,50 @@
+#ifndef SPANNING_FOREST_H
+#define SPANNING_FOREST_H
+
+#include <vector>
+#include <tuple>
+#include <utility>
+#include <iostream>
+
+// SpanningForest is a minimum spanning tree of every connected component of a graph, stored as a flat edge list.
+// Edges are ordered by weight, ties broken by the endpoints, so the forest can be cut by weight for clustering.
+class SpanningForest
+{
+public:
+    struct Link
+    {
+        // Endpoints with u < v.
+        int u;
+        int v;
+        int weight;
+
+        friend bool operator<(const Link &lhs, const Link &rhs)
+        {
+            return std::tie(lhs.weight, lhs.u, lhs.v) < std::tie(rhs.weight, rhs.u, rhs.v);
+        }
+    };
+
+    int verticesCount;
+    std::vector<Link> edges;
+    long long totalWeight;
+
+    SpanningForest(int V, std::vector<Link> links) : verticesCount(V), edges(std::move(links)), totalWeight(0)
+    {
+        for (const Link &link : edges)
+            totalWeight += link.weight;
+    }
+
+    // Every edge of a forest joins two trees, so the number of trees follows from the edge count.
+    int componentsCount() const { return verticesCount - static_cast<int>(edges.size()); }
+    bool isSpanningTree() const { return verticesCount > 0 && componentsCount() == 1; }
+
+    friend std::ostream &operator<<(std::ostream &os, const SpanningForest &obj)
+    {
+        for (const Link &link : obj.edges)
+            os << link.u << " - " << link.v << " (" << link.weight << ")" << std::endl;
+        os << "Total weight: " << obj.totalWeight << ", components: " << obj.componentsCount() << std::endl;
+        return os;
+    }
+};
+
+#endif // SPANNING_FOREST_H
@@ -0,0 +1,100 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(int threads)
+{
+    if (threads <= 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 1; i < threads; ++i)
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (auto &worker : workers)
+        worker.join();
+}
+
+void ThreadPool::parallelFor(int count, int grain, const RangeBody &body)
+{
+    if (count <= 0)
+        return;
+
+    if (workers.empty() || count <= grain)
+    {
+        body(0, 0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->body = &body;
+        this->count = count;
+        this->grain = std::max(1, grain);
+        next.store(0);
+        error = nullptr;
+        running = static_cast<int>(workers.size());
+        ++generation;
+    }
+    wakeUp.notify_all();
+
+    runChunks(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this]
+                  { return running == 0; });
+    this->body = nullptr;
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+void ThreadPool::workerLoop(int worker)
+{
+    long long seen = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeUp.wait(lock, [this, seen]
+                        { return stopping || generation != seen; });
+            if (stopping)
+                return;
+            seen = generation;
+        }
+
+        runChunks(worker);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--running == 0)
+            finished.notify_one();
+    }
+}
+
+void ThreadPool::runChunks(int worker)
+{
+    while (true)
+    {
+        int begin = next.fetch_add(grain);
+        if (begin >= count)
+            return;
+
+        try
+        {
+            (*body)(worker, begin, std::min(begin + grain, count));
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error)
+                error = std::current_exception();
+            next.store(count);
+        }
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <exception>
+
+// ThreadPool keeps a fixed set of worker threads alive between parallel loops.
+// The calling thread takes part in every loop as worker 0, so a pool of size 1 runs everything inline.
+class ThreadPool
+{
+public:
+    // Loop body receiving the worker index in [0, size()) and a half-open index range.
+    using RangeBody = std::function<void(int worker, int begin, int end)>;
+
+    // Non-positive thread counts select the hardware concurrency.
+    explicit ThreadPool(int threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    int size() const { return static_cast<int>(workers.size()) + 1; }
+
+    // Splits [0, count) into chunks of at most grain indices, runs them on all workers and blocks until done.
+    // The first exception thrown by the body is rethrown in the calling thread.
+    void parallelFor(int count, int grain, const RangeBody &body);
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::condition_variable finished;
+
+    const RangeBody *body = nullptr;
+    int count = 0;
+    int grain = 1;
+    std::atomic<int> next{0};
+    long long generation = 0;
+    int running = 0;
+    bool stopping = false;
+    std::exception_ptr error;
+
+    void workerLoop(int worker);
+    void runChunks(int worker);
+};
+
+#endif // THREAD_POOL_H
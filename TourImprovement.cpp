@@ -0,0 +1,12 @@
+#include "TourImprovement.h"
+#include "KdTree.h"
+
+std::vector<int> candidateLists(const EuclideanGraph &graph, int k)
+{
+    std::vector<int> lists(static_cast<std::size_t>(graph.verticesCount()) * k, -1);
+    int available = std::max(0, std::min(k, graph.verticesCount() - 1));
+    std::vector<int> nearest = KdTree(graph).nearestNeighborLists(available);
+    for (int u = 0; u < graph.verticesCount(); ++u)
+        std::copy_n(nearest.begin() + static_cast<std::size_t>(u) * available, available, lists.begin() + static_cast<std::size_t>(u) * k);
+    return lists;
+}
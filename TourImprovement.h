@@ -0,0 +1,554 @@
+#ifndef TOUR_IMPROVEMENT_H
+#define TOUR_IMPROVEMENT_H
+
+#include <vector>
+#include <limits>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+#include <random>
+#include <array>
+#include "ArrayTour.h"
+#include "EuclideanGraph.h"
+
+// Candidate lists of the k lightest edges of every vertex, stored row-major with k entries per vertex in increasing
+// weight. Rows of vertices with fewer than k neighbours are padded with -1.
+template <typename TGraph>
+std::vector<int> candidateLists(const TGraph &graph, int k)
+{
+    int V = graph.verticesCount();
+    std::vector<int> lists(static_cast<std::size_t>(V) * k, -1);
+    std::vector<std::pair<int, int>> row;
+    for (int u = 0; u < V; ++u)
+    {
+        row.clear();
+        for (const Arc &arc : graph.neighbors(u))
+        {
+            if (arc.dest != u)
+                row.emplace_back(arc.weight, arc.dest);
+        }
+
+        int count = std::min(k, static_cast<int>(row.size()));
+        std::partial_sort(row.begin(), row.begin() + count, row.end());
+        for (int i = 0; i < count; ++i)
+            lists[static_cast<std::size_t>(u) * k + i] = row[i].second;
+    }
+    return lists;
+}
+
+// The k nearest cities of every city from a k-d tree, in O(n log n) instead of sorting all n - 1 distances.
+std::vector<int> candidateLists(const EuclideanGraph &graph, int k);
+
+// Statistics of a running tour improvement, passed to progress callbacks.
+struct TourProgress
+{
+    // Improving moves applied, including those rolled back with a rejected kick.
+    long long moves = 0;
+    long long kicks = 0;
+    long long initialLength = 0;
+    long long currentLength = 0;
+    long long bestLength = 0;
+    double elapsed = 0;
+
+    double gainPerSecond() const { return elapsed > 0 ? (initialLength - bestLength) / elapsed : 0; }
+};
+
+using TourProgressCallback = std::function<void(const TourProgress &progress)>;
+
+// LocalSearch improves a tour with 2-opt (or sequential 3-opt) and Or-opt moves restricted to candidate lists.
+// Vertices whose surroundings did not change since their last unsuccessful scan are not scanned again
+// (don't-look bits): only endpoints of applied moves are put back into the work queue.
+// Every move is a sequence of 2-opt flips recorded in a journal, so unprofitable steps can be rolled back.
+template <typename TGraph>
+class LocalSearch
+{
+public:
+    // Longest segment moved by an Or-opt move.
+    static constexpr int MaxSegmentLength = 3;
+    // Longest of the two adjacent segments swapped by a kick.
+    static constexpr int MaxKickSegmentLength = 50;
+    // Seconds between two progress callbacks.
+    static constexpr double ProgressInterval = 0.5;
+
+    // Uses first-improvement 2-opt moves, or the best sequential 3-opt move of each vertex if threeOpt is set.
+    LocalSearch(const TGraph &graph, const std::vector<int> &tour, const std::vector<int> &candidates, bool threeOpt = false)
+        : graph(graph), tour(tour), candidates(candidates), threeOpt(threeOpt), inQueue(tour.size(), false)
+    {
+        int V = this->tour.size();
+        if (V != graph.verticesCount())
+            throw std::invalid_argument("The tour must visit every vertex of the graph.");
+        k = V == 0 ? 0 : static_cast<int>(candidates.size() / V);
+
+        for (int p = 0; p < V; ++p)
+        {
+            int u = this->tour.at(p);
+            length += cost(u, this->tour.next(u));
+            activate(u);
+        }
+        stats.initialLength = stats.currentLength = stats.bestLength = length;
+    }
+
+    // Applies improving moves until none is left or timeLimit seconds have passed (non-positive means no limit).
+    // Returns the number of moves applied.
+    long long run(double timeLimit = 0)
+    {
+        start(timeLimit, nullptr);
+        descend();
+        finish();
+        return stats.moves;
+    }
+
+    // Anytime search: descends to a local optimum, then keeps kicking the tour (swapping two short adjacent
+    // segments, a local double bridge) and descending again until timeLimit seconds have passed. Kicks that do not
+    // lead to a shorter tour are rolled back, so the current tour is always the best one found.
+    // Non-positive timeLimit stops at the first local optimum. The callback, if any, receives periodic statistics.
+    TourProgress iterate(double timeLimit, const TourProgressCallback &progress = nullptr, unsigned seed = 0)
+    {
+        start(timeLimit, progress);
+        bool inTime = descend();
+
+        std::mt19937 rng(seed);
+        keepJournal = true;
+        while (inTime && timeLimit > 0 && tour.size() >= 8)
+        {
+            journal.clear();
+            kick(rng);
+            inTime = descend();
+            if (length < stats.bestLength)
+                stats.bestLength = length;
+            else
+                undo(0);
+            inTime = inTime && checkClock();
+        }
+        journal.clear();
+        keepJournal = false;
+
+        finish();
+        return stats;
+    }
+
+    const ArrayTour &currentTour() const { return tour; }
+    const TourProgress &progress() const { return stats; }
+
+    // Weight of the current tour; edges missing from the graph do not count, as in doubleTreeTSP.
+    int tourWeight() const
+    {
+        int total = 0;
+        for (int p = 0; p < tour.size(); ++p)
+        {
+            int u = tour.at(p);
+            int v = tour.next(u);
+            if (graph.hasEdge(u, v))
+                total += graph.weight(u, v);
+        }
+        return total;
+    }
+
+private:
+    // Cost of an edge missing from the graph; small enough that sums of a few of them do not overflow.
+    static constexpr int MissingEdge = std::numeric_limits<int>::max() / 8;
+
+    const TGraph &graph;
+    ArrayTour tour;
+    const std::vector<int> &candidates;
+    int k = 0;
+    bool threeOpt;
+    std::vector<int> queue;
+    std::size_t queueHead = 0;
+    std::vector<bool> inQueue;
+
+    // Flips (a, b, c, d) applied since the last accepted state, undone in reverse order.
+    std::vector<std::array<int, 4>> journal;
+    bool keepJournal = false;
+    long long length = 0;
+
+    TourProgress stats;
+    std::chrono::high_resolution_clock::time_point startTime;
+    double timeLimit = 0;
+    double lastReport = 0;
+    TourProgressCallback report;
+
+    int cost(int u, int v) const { return graph.hasEdge(u, v) ? graph.weight(u, v) : MissingEdge; }
+
+    void flip(int a, int b, int c, int d)
+    {
+        length += static_cast<long long>(cost(a, c)) + cost(b, d) - cost(a, b) - cost(c, d);
+        tour.twoOptMove(a, b, c, d);
+        journal.push_back({a, b, c, d});
+    }
+
+    void undo(std::size_t mark)
+    {
+        while (journal.size() > mark)
+        {
+            const auto &entry = journal.back();
+            // After the flip the tour reads a, c, ..., b, d, so flipping again restores (a, b) and (c, d).
+            tour.twoOptMove(entry[0], entry[2], entry[1], entry[3]);
+            length -= static_cast<long long>(cost(entry[0], entry[2])) + cost(entry[1], entry[3]) - cost(entry[0], entry[1]) - cost(entry[2], entry[3]);
+            journal.pop_back();
+        }
+    }
+
+    void start(double limit, const TourProgressCallback &progress)
+    {
+        startTime = std::chrono::high_resolution_clock::now();
+        timeLimit = limit;
+        lastReport = 0;
+        report = progress;
+    }
+
+    // Refreshes the statistics, reports them once per ProgressInterval and returns false once the time is up.
+    bool checkClock()
+    {
+        std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - startTime;
+        stats.elapsed = elapsed.count();
+        stats.currentLength = length;
+        // Outside of kicks the tour only gets shorter, so the current tour is the best one.
+        if (!keepJournal)
+            stats.bestLength = length;
+        if (report && stats.elapsed - lastReport >= ProgressInterval)
+        {
+            lastReport = stats.elapsed;
+            report(stats);
+        }
+        return timeLimit <= 0 || stats.elapsed < timeLimit;
+    }
+
+    void finish()
+    {
+        checkClock();
+        stats.bestLength = std::min(stats.bestLength, length);
+        stats.currentLength = length;
+        if (report)
+            report(stats);
+    }
+
+    // Processes queued vertices until the queue is empty (true) or the time is up (false).
+    bool descend()
+    {
+        long long scans = 0;
+        while (queueHead < queue.size())
+        {
+            if (++scans % 256 == 0 && !checkClock())
+                return false;
+
+            int vertex = queue[queueHead++];
+            inQueue[vertex] = false;
+            if (queueHead == queue.size())
+            {
+                queue.clear();
+                queueHead = 0;
+            }
+
+            bool improved = threeOpt ? improveThreeOpt(vertex) : improveTwoOpt(vertex);
+            if (improved || improveOrOpt(vertex))
+                ++stats.moves;
+            if (!keepJournal)
+                journal.clear();
+        }
+        return true;
+    }
+
+    void activate(int vertex)
+    {
+        if (!inQueue[vertex])
+        {
+            inQueue[vertex] = true;
+            queue.push_back(vertex);
+        }
+    }
+
+    // Replaces tour edges (a, succ a) and (c, succ c), or (pred a, a) and (pred c, c), with (a, c) and the edge
+    // joining the other two endpoints. Candidates are sorted, so the scan stops once (a, c) is no shorter than
+    // the edge it would replace.
+    bool improveTwoOpt(int a)
+    {
+        for (int direction = 0; direction < 2; ++direction)
+        {
+            int b = direction == 0 ? tour.next(a) : tour.prev(a);
+            int removed = cost(a, b);
+            for (int i = 0; i < k; ++i)
+            {
+                int c = candidates[static_cast<std::size_t>(a) * k + i];
+                if (c == -1)
+                    break;
+
+                int added = cost(a, c);
+                if (added >= removed)
+                    break;
+
+                int d = direction == 0 ? tour.next(c) : tour.prev(c);
+                if (c == b || d == a)
+                    continue;
+
+                if (added + cost(b, d) < removed + cost(c, d))
+                {
+                    if (direction == 0)
+                        flip(a, b, c, d);
+                    else
+                        flip(b, a, d, c);
+
+                    activate(a);
+                    activate(b);
+                    activate(c);
+                    activate(d);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // Moves the segment of up to MaxSegmentLength vertices starting at a between two adjacent vertices x -> y near
+    // one of its ends, keeping or reversing its orientation, whichever is cheaper.
+    bool improveOrOpt(int a)
+    {
+        int n = tour.size();
+        int s2 = a;
+        for (int length = 1; length <= MaxSegmentLength && length + 3 <= n; ++length)
+        {
+            if (length > 1)
+                s2 = tour.next(s2);
+
+            int s1 = a;
+            int p = tour.prev(s1);
+            int q = tour.next(s2);
+            int removeGain = cost(p, s1) + cost(s2, q) - cost(p, q);
+            if (removeGain <= 0)
+                continue;
+
+            for (int end = 0; end < 2; ++end)
+            {
+                int e = end == 0 ? s1 : s2;
+                for (int i = 0; i < k; ++i)
+                {
+                    int c = candidates[static_cast<std::size_t>(e) * k + i];
+                    if (c == -1 || cost(e, c) >= removeGain)
+                        break;
+                    if (tour.distanceAlong(s1, c) < length)
+                        continue;
+
+                    for (int side = 0; side < 2; ++side)
+                    {
+                        int x = side == 0 ? c : tour.prev(c);
+                        int y = side == 0 ? tour.next(c) : c;
+                        // Insertions next to p or q are 2-opt moves or Or-opt moves of p or q, covered elsewhere.
+                        if (x == s2 || y == s1 || x == q || y == p)
+                            continue;
+
+                        int forward = cost(x, s1) + cost(s2, y) - cost(x, y);
+                        int reversed = cost(x, s2) + cost(s1, y) - cost(x, y);
+                        if (std::min(forward, reversed) >= removeGain)
+                            continue;
+
+                        moveSegment(p, s1, s2, q, x, y, forward < reversed);
+                        activate(p);
+                        activate(q);
+                        activate(s1);
+                        activate(s2);
+                        activate(x);
+                        activate(y);
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    // Best sequential 3-opt move from t1 (Or-3opt): breaks (t1, t2), joins t2 to a candidate t3 and breaks a tour
+    // edge (t3, t4), then joins t4 to a candidate t5 and breaks (t5, t6) so that closing with (t6, t1) gives a tour.
+    // Partial gains must stay positive, which prunes the candidate scans. Moves are evaluated on the unchanged
+    // tour and only the best improving one is applied, so tentative moves cost no flips. Closing right after
+    // (t3, t4) is a 2-opt move and is included.
+    bool improveThreeOpt(int t1)
+    {
+        long long bestGain = 0;
+        std::array<int, 6> best{};
+        int bestType = -1;
+
+        for (int side = 0; side < 2; ++side)
+        {
+            bool forward = side == 0;
+            auto succ = [&](int v) { return forward ? tour.next(v) : tour.prev(v); };
+            auto pred = [&](int v) { return forward ? tour.prev(v) : tour.next(v); };
+            // True if b lies on the path a -> c walked in the direction of this side.
+            auto between = [&](int a, int b, int c) { return forward ? tour.between(a, b, c) : tour.between(c, b, a); };
+
+            int t2 = succ(t1);
+            for (int i = 0; i < k; ++i)
+            {
+                int t3 = candidates[static_cast<std::size_t>(t2) * k + i];
+                long long g1 = t3 == -1 ? 0 : static_cast<long long>(cost(t1, t2)) - cost(t2, t3);
+                if (g1 <= 0)
+                    break;
+                if (t3 == t1 || t3 == succ(t2))
+                    continue;
+
+                // Type 0 breaks (t3, pred t3) and can close at once; type 1 breaks (t3, succ t3), which leaves the
+                // cycle t2 .. t3 that the second exchange has to open.
+                for (int type = 0; type < 2; ++type)
+                {
+                    int t4 = type == 0 ? pred(t3) : succ(t3);
+                    if (t4 == t1 || t4 == t2)
+                        continue;
+
+                    long long g1Closed = g1 + cost(t3, t4);
+                    if (type == 0 && g1Closed - cost(t4, t1) > bestGain)
+                    {
+                        bestGain = g1Closed - cost(t4, t1);
+                        best = {t1, t2, t3, t4, -1, -1};
+                        bestType = 0;
+                    }
+
+                    for (int j = 0; j < k; ++j)
+                    {
+                        int t5 = candidates[static_cast<std::size_t>(t4) * k + j];
+                        long long g2 = t5 == -1 ? 0 : g1Closed - cost(t4, t5);
+                        if (g2 <= 0)
+                            break;
+                        if (t5 == t1 || t5 == t2 || t5 == t3)
+                            continue;
+
+                        if (type == 0)
+                        {
+                            // After the first flip the tour reads t1 t4 .. t2 t3 .., with t2 .. t4 reversed.
+                            int t6 = between(t2, t5, t4) ? succ(t5) : pred(t5);
+                            long long gain = g2 + cost(t5, t6) - cost(t6, t1);
+                            if (gain > bestGain)
+                            {
+                                bestGain = gain;
+                                best = {t1, t2, t3, t4, t5, t6};
+                                bestType = 1;
+                            }
+                            continue;
+                        }
+
+                        if (!between(t2, t5, t3))
+                            continue;
+
+                        for (int next = 0; next < 2; ++next)
+                        {
+                            if ((next == 1 && t5 == t3) || (next == 0 && t5 == t2))
+                                continue;
+
+                            int t6 = next == 1 ? succ(t5) : pred(t5);
+                            long long gain = g2 + cost(t5, t6) - cost(t6, t1);
+                            if (gain > bestGain)
+                            {
+                                bestGain = gain;
+                                best = {t1, t2, t3, t4, t5, t6};
+                                bestType = next == 1 ? 2 : 3;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        if (bestType == -1)
+            return false;
+
+        int t1Best = best[0], t2Best = best[1], t3Best = best[2], t4Best = best[3], t5Best = best[4], t6Best = best[5];
+        switch (bestType)
+        {
+        case 0:
+            flip(t1Best, t2Best, t4Best, t3Best);
+            break;
+        case 1:
+            flip(t1Best, t2Best, t4Best, t3Best);
+            flip(t1Best, t4Best, t6Best, t5Best);
+            break;
+        case 2:
+            // t1 [t2 .. t5] [t6 .. t3] t4 becomes t1 [t6 .. t3] [t2 .. t5] t4.
+            moveSegment(t1Best, t2Best, t5Best, t6Best, t3Best, t4Best, true);
+            break;
+        default:
+            // t1 [t2 .. t6] [t5 .. t3] t4 becomes t1 [t6 .. t2] [t3 .. t5] t4.
+            flip(t1Best, t2Best, t6Best, t5Best);
+            flip(t2Best, t5Best, t3Best, t4Best);
+            break;
+        }
+
+        for (int vertex : best)
+        {
+            if (vertex != -1)
+                activate(vertex);
+        }
+        return true;
+    }
+
+    // Tour p s1..s2 q ... x y becomes p q ... x s1..s2 y (or x s2..s1 y) through two or three 2-opt moves.
+    void moveSegment(int p, int s1, int s2, int q, int x, int y, bool keepOrientation)
+    {
+        flip(p, s1, x, y);
+        flip(p, x, q, s2);
+        if (keepOrientation && s1 != s2)
+            flip(x, s2, s1, y);
+    }
+
+    // Swaps two random adjacent segments: p A B y becomes p B A y.
+    void kick(std::mt19937 &rng)
+    {
+        int maxLength = std::min(MaxKickSegmentLength, (tour.size() - 3) / 2);
+        std::uniform_int_distribution<int> segmentLength(1, maxLength);
+        std::uniform_int_distribution<int> position(0, tour.size() - 1);
+
+        int s1 = tour.at(position(rng));
+        int s2 = s1;
+        for (int i = segmentLength(rng); i > 1; --i)
+            s2 = tour.next(s2);
+        int q = tour.next(s2);
+        int x = q;
+        for (int i = segmentLength(rng); i > 1; --i)
+            x = tour.next(x);
+        int p = tour.prev(s1);
+        int y = tour.next(x);
+
+        moveSegment(p, s1, s2, q, x, y, true);
+        for (int vertex : {p, s1, s2, q, x, y})
+            activate(vertex);
+        ++stats.kicks;
+    }
+};
+
+// Improves a closed tour returned by one of the TSP heuristics with 2-opt and Or-opt moves over the candidate lists.
+// timeLimit bounds the improvement in seconds (non-positive means run to a local optimum). The returned tour
+// starts and ends at the same vertex as the input tour.
+template <typename TGraph>
+std::pair<std::pair<std::vector<int>, int>, double> twoOptTSP(const TGraph &graph, const std::vector<int> &tour,
+                                                              const std::vector<int> &candidates, double timeLimit = 0)
+{
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    LocalSearch<TGraph> search(graph, tour, candidates);
+    search.run(timeLimit);
+    std::vector<int> improved = tour.empty() ? tour : search.currentTour().closedTour(tour.front());
+    int totalWeight = search.tourWeight();
+
+    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start_time;
+    return std::make_pair(std::make_pair(improved, totalWeight), duration.count());
+}
+
+// Or-3opt improvement of a closed tour: sequential 3-opt moves, the depth-three Lin-Kernighan step, plus Or-opt moves.
+// With a positive timeLimit it runs as an anytime search that keeps kicking the local optimum and returns the best
+// tour found when the time is up; otherwise it stops at the first local optimum. The callback receives statistics
+// (moves, kicks, current and best length, gain per second) every ProgressInterval seconds and once at the end.
+template <typename TGraph>
+std::pair<std::pair<std::vector<int>, int>, double> orThreeOptTSP(const TGraph &graph, const std::vector<int> &tour,
+                                                                    const std::vector<int> &candidates, double timeLimit = 0,
+                                                                    const TourProgressCallback &progress = nullptr, unsigned seed = 0)
+{
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    LocalSearch<TGraph> search(graph, tour, candidates, true);
+    search.iterate(timeLimit, progress, seed);
+    std::vector<int> improved = tour.empty() ? tour : search.currentTour().closedTour(tour.front());
+    int totalWeight = search.tourWeight();
+
+    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start_time;
+    return std::make_pair(std::make_pair(improved, totalWeight), duration.count());
+}
+
+#endif // TOUR_IMPROVEMENT_H
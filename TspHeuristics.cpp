@@ -0,0 +1,374 @@
+#include "TspHeuristics.h"
+#include "KdTree.h"
+#include "UnionFind.h"
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+std::pair<std::pair<std::vector<int>, int>, double> nearestNeighborTSP(const EuclideanGraph &graph, int start)
+{
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    KdTree tree(graph);
+    std::vector<int> tour;
+    tour.reserve(graph.verticesCount() + 1);
+    int totalWeight = 0;
+    int current = start;
+    tour.push_back(current);
+    tree.remove(current);
+
+    while (tree.aliveCount() > 0)
+    {
+        int next = tree.nearest(current);
+        tree.remove(next);
+        tour.push_back(next);
+        totalWeight += graph.weight(current, next);
+        current = next;
+    }
+
+    tour.push_back(start);
+    totalWeight += graph.weight(current, start);
+
+    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start_time;
+    return std::make_pair(std::make_pair(tour, totalWeight), duration.count());
+}
+
+std::vector<VertexInfo> euclideanMST(const EuclideanGraph &graph, int start)
+{
+    int V = graph.verticesCount();
+    if (V == 0)
+        return {};
+
+    KdTree tree(graph);
+    UnionFind components(V);
+    std::vector<std::pair<int, int>> edges;
+    edges.reserve(V - 1);
+
+    // Shortest outgoing edge of every component root as (squared length, lower endpoint, higher endpoint). Comparing
+    // the endpoints as well gives every edge a distinct key, so equal lengths cannot close a cycle within a round.
+    const std::int64_t unset = std::numeric_limits<std::int64_t>::max();
+    std::vector<std::tuple<std::int64_t, int, int>> shortest(V);
+    std::vector<int> labels(V);
+    std::vector<std::int64_t> lowerBound(V, 0);
+
+    while (components.setsCount() > 1)
+    {
+        for (int v = 0; v < V; ++v)
+        {
+            labels[v] = components.find(v);
+            shortest[v] = std::make_tuple(unset, -1, -1);
+        }
+        tree.setLabels(labels);
+
+        // Queries run in tree order so consecutive ones touch the same nodes. The nearest city of another component
+        // only moves away as components merge, so a city whose previous answer is already longer than the best edge
+        // of its component is skipped.
+        for (int position = 0; position < V; ++position)
+        {
+            int v = tree.at(position);
+            auto &best = shortest[labels[v]];
+            if (lowerBound[v] > std::get<0>(best))
+                continue;
+
+            std::pair<std::int64_t, int> found = tree.nearestWithOtherLabel(v, std::get<0>(best));
+            if (found.second == -1)
+            {
+                lowerBound[v] = found.first + 1;
+                continue;
+            }
+
+            lowerBound[v] = found.first;
+
+            auto candidate = std::make_tuple(found.first, std::min(v, found.second), std::max(v, found.second));
+            if (candidate < best)
+                best = candidate;
+        }
+
+        for (int v = 0; v < V; ++v)
+        {
+            if (labels[v] != v || std::get<1>(shortest[v]) == -1)
+                continue;
+
+            int a = std::get<1>(shortest[v]);
+            int b = std::get<2>(shortest[v]);
+            if (components.unite(a, b))
+                edges.emplace_back(a, b);
+        }
+    }
+
+    std::vector<int> offsets(V + 1, 0);
+    for (const auto &edge : edges)
+    {
+        ++offsets[edge.first + 1];
+        ++offsets[edge.second + 1];
+    }
+    for (int v = 0; v < V; ++v)
+        offsets[v + 1] += offsets[v];
+
+    std::vector<int> adjacency(offsets[V]);
+    std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (const auto &edge : edges)
+    {
+        adjacency[fill[edge.first]++] = edge.second;
+        adjacency[fill[edge.second]++] = edge.first;
+    }
+
+    // Orient the tree away from start in breadth-first order.
+    std::vector<VertexInfo> mst;
+    mst.reserve(V);
+    std::vector<bool> reached(V, false);
+    mst.emplace_back(start, 0, -1);
+    reached[start] = true;
+    for (std::size_t i = 0; i < mst.size(); ++i)
+    {
+        int u = mst[i].vertex;
+        for (int j = offsets[u]; j < offsets[u + 1]; ++j)
+        {
+            int v = adjacency[j];
+            if (reached[v])
+                continue;
+
+            reached[v] = true;
+            mst.emplace_back(v, graph.weight(u, v), u);
+        }
+    }
+
+    return mst;
+}
+
+std::pair<std::pair<std::vector<int>, int>, double> doubleTreeTSP(const EuclideanGraph &graph, int start)
+{
+    int V = graph.verticesCount();
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    std::vector<int> preorder = preorderWalk(V, euclideanMST(graph, start));
+    preorder.push_back(preorder.front());
+
+    int totalWeight = 0;
+    for (std::size_t i = 0; i + 1 < preorder.size(); ++i)
+        totalWeight += graph.weight(preorder[i], preorder[i + 1]);
+
+    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start_time;
+    return std::make_pair(std::make_pair(preorder, totalWeight), duration.count());
+}
+
+std::pair<std::pair<std::vector<int>, int>, double> hilbertCurveTSP(const EuclideanGraph &graph, int start)
+{
+    std::vector<City> cities;
+    cities.reserve(graph.verticesCount());
+    for (int v = 0; v < graph.verticesCount(); ++v)
+        cities.push_back(graph.city(v));
+
+    return hilbertCurveTSP<EuclideanGraph>(graph, cities, start);
+}
+
+// Odd cities considered as matching partners of each odd city.
+static constexpr int MatchingCandidates = 8;
+
+std::pair<std::pair<std::vector<int>, int>, double> christofidesTSP(const EuclideanGraph &graph, int start)
+{
+    int V = graph.verticesCount();
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    std::vector<VertexInfo> mst = euclideanMST(graph, start);
+    std::vector<int> odd = oddDegreeVertices(V, mst);
+    int count = static_cast<int>(odd.size());
+
+    // The odd cities form their own point set, indexed by their position in odd.
+    std::vector<City> oddCities;
+    oddCities.reserve(count);
+    for (int i = 0; i < count; ++i)
+        oddCities.emplace_back(i, graph.x(odd[i]), graph.y(odd[i]));
+    EuclideanGraph oddGraph(oddCities);
+    KdTree tree(oddGraph);
+
+    int k = std::min(MatchingCandidates, std::max(0, count - 1));
+    std::vector<int> lists = tree.nearestNeighborLists(k);
+    std::vector<std::tuple<std::int64_t, int, int>> pairs;
+    pairs.reserve(static_cast<std::size_t>(count) * k);
+    for (int i = 0; i < count; ++i)
+    {
+        for (int j = 0; j < k; ++j)
+        {
+            int other = lists[static_cast<std::size_t>(i) * k + j];
+            if (other < i)
+                continue;
+
+            std::int64_t dx = static_cast<std::int64_t>(oddGraph.x(i)) - oddGraph.x(other);
+            std::int64_t dy = static_cast<std::int64_t>(oddGraph.y(i)) - oddGraph.y(other);
+            pairs.emplace_back(dx * dx + dy * dy, i, other);
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+
+    std::vector<std::pair<int, int>> matching;
+    matching.reserve(count / 2);
+    for (const auto &pair : pairs)
+    {
+        int a = std::get<1>(pair);
+        int b = std::get<2>(pair);
+        if (!tree.contains(a) || !tree.contains(b))
+            continue;
+
+        tree.remove(a);
+        tree.remove(b);
+        matching.emplace_back(odd[a], odd[b]);
+    }
+
+    // Leftovers in preorder, each with its nearest leftover.
+    for (int i = 0; i < count; ++i)
+    {
+        if (!tree.contains(i))
+            continue;
+
+        tree.remove(i);
+        int other = tree.nearest(i);
+        tree.remove(other);
+        matching.emplace_back(odd[i], odd[other]);
+    }
+
+    std::vector<int> tour = eulerShortcut(V, mst, matching, start);
+
+    int totalWeight = 0;
+    for (std::size_t i = 0; i + 1 < tour.size(); ++i)
+        totalWeight += graph.weight(tour[i], tour[i + 1]);
+
+    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start_time;
+    return std::make_pair(std::make_pair(tour, totalWeight), duration.count());
+}
+
+// Tour edges below which the insertion scan stays on the calling thread.
+static constexpr int ParallelInsertionEdges = 8192;
+
+// Tour edges of random insertion in structure-of-arrays form: slot i is the edge from[i] -> to[i].
+// Costs use double coordinates, which is exact for coordinate differences below 2^26.
+struct InsertionEdges
+{
+    std::vector<int> from;
+    std::vector<int> to;
+    std::vector<double> fromX;
+    std::vector<double> fromY;
+    std::vector<double> toX;
+    std::vector<double> toY;
+    std::vector<int> lengths;
+
+    int size() const { return static_cast<int>(from.size()); }
+
+    void set(const EuclideanGraph &graph, int slot, int u, int v)
+    {
+        if (slot == size())
+        {
+            from.push_back(u);
+            to.push_back(v);
+            fromX.push_back(graph.x(u));
+            fromY.push_back(graph.y(u));
+            toX.push_back(graph.x(v));
+            toY.push_back(graph.y(v));
+            lengths.push_back(graph.weight(u, v));
+            return;
+        }
+
+        from[slot] = u;
+        to[slot] = v;
+        fromX[slot] = graph.x(u);
+        fromY[slot] = graph.y(u);
+        toX[slot] = graph.x(v);
+        toY[slot] = graph.y(v);
+        lengths[slot] = graph.weight(u, v);
+    }
+};
+
+std::pair<std::pair<std::vector<int>, int>, double> randomInsertionTSP(const EuclideanGraph &graph, int start1, int start2,
+                                                                       ThreadPool &pool, unsigned seed)
+{
+    int V = graph.verticesCount();
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    InsertionEdges edges;
+    edges.set(graph, 0, start1, start2);
+    edges.set(graph, 1, start2, start1);
+    std::vector<int> next(V, -1);
+    next[start1] = start2;
+    next[start2] = start1;
+
+    std::vector<int> unvisited;
+    unvisited.reserve(V);
+    for (int i = 0; i < V; ++i)
+    {
+        if (i != start1 && i != start2)
+            unvisited.push_back(i);
+    }
+
+    // Best (cost, slot) of every worker and its buffer of per-edge costs.
+    std::vector<std::pair<int, int>> workerBest(pool.size());
+    std::vector<std::vector<int>> workerCosts(pool.size());
+    double x = 0;
+    double y = 0;
+
+    ThreadPool::RangeBody scan = [&](int worker, int begin, int end)
+    {
+        std::vector<int> &costs = workerCosts[worker];
+        costs.resize(end - begin);
+        const double *fromX = edges.fromX.data();
+        const double *fromY = edges.fromY.data();
+        const double *toX = edges.toX.data();
+        const double *toY = edges.toY.data();
+        const int *lengths = edges.lengths.data();
+
+        // Kept free of branches so the compiler can vectorize it.
+        for (int i = begin; i < end; ++i)
+        {
+            double dx1 = fromX[i] - x;
+            double dy1 = fromY[i] - y;
+            double dx2 = toX[i] - x;
+            double dy2 = toY[i] - y;
+            costs[i - begin] = static_cast<int>(std::sqrt(dx1 * dx1 + dy1 * dy1)) + static_cast<int>(std::sqrt(dx2 * dx2 + dy2 * dy2)) - lengths[i];
+        }
+
+        auto best = std::min_element(costs.begin(), costs.end());
+        std::pair<int, int> candidate(*best, begin + static_cast<int>(best - costs.begin()));
+        workerBest[worker] = std::min(workerBest[worker], candidate);
+    };
+
+    std::mt19937 rng(seed);
+    while (!unvisited.empty())
+    {
+        int randIndex = std::uniform_int_distribution<int>(0, static_cast<int>(unvisited.size()) - 1)(rng);
+        int newVertex = unvisited[randIndex];
+        unvisited[randIndex] = unvisited.back();
+        unvisited.pop_back();
+
+        x = graph.x(newVertex);
+        y = graph.y(newVertex);
+        std::fill(workerBest.begin(), workerBest.end(), std::make_pair(std::numeric_limits<int>::max(), std::numeric_limits<int>::max()));
+
+        int count = edges.size();
+        if (count >= ParallelInsertionEdges && pool.size() > 1)
+            pool.parallelFor(count, std::max(ParallelInsertionEdges / 4, count / (4 * pool.size()) + 1), scan);
+        else
+            scan(0, 0, count);
+
+        int slot = std::min_element(workerBest.begin(), workerBest.end())->second;
+        int u = edges.from[slot];
+        int v = edges.to[slot];
+        edges.set(graph, slot, u, newVertex);
+        edges.set(graph, edges.size(), newVertex, v);
+        next[u] = newVertex;
+        next[newVertex] = v;
+    }
+
+    std::vector<int> tour;
+    tour.reserve(V + 1);
+    int totalWeight = 0;
+    int current = start1;
+    for (int i = 0; i < V; ++i)
+    {
+        tour.push_back(current);
+        totalWeight += graph.weight(current, next[current]);
+        current = next[current];
+    }
+    tour.push_back(start1);
+
+    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start_time;
+    return std::make_pair(std::make_pair(tour, totalWeight), duration.count());
+}
@@ -0,0 +1,479 @@
+#ifndef TSP_HEURISTICS_H
+#define TSP_HEURISTICS_H
+
+#include <vector>
+#include <stack>
+#include <limits>
+#include <chrono>
+#include <random>
+#include <tuple>
+#include <algorithm>
+#include "Graph.h"
+#include "EuclideanGraph.h"
+#include "IndexedMinHeap.h"
+#include "ThreadPool.h"
+#include "HilbertCurve.h"
+
+// MST and TSP construction heuristics shared by every graph representation. TGraph must provide verticesCount(),
+// neighbors(u) yielding Arc values, hasEdge(u, v) and weight(u, v), as CsrGraph and EuclideanGraph do.
+// Tours start and end with the same vertex; each heuristic returns the tour with its weight and its duration.
+
+template <typename TGraph>
+std::vector<VertexInfo> primMST(const TGraph &graph, int start)
+{
+    int V = graph.verticesCount();
+    std::vector<VertexInfo> mst;
+
+    auto maxValue = std::numeric_limits<int>::max() / 2;
+    std::vector<VertexInfo> vertices;
+    std::vector<int> keys;
+    for (int i = 0; i < V; ++i)
+    {
+        vertices.emplace_back(VertexInfo(i, (i == start ? 0 : maxValue), -1));
+        keys.push_back(vertices.back().distance);
+    }
+
+    IndexedMinHeap<int> minHeap(keys);
+    while (!minHeap.isEmpty())
+    {
+        int u = minHeap.extractMin().second;
+        vertices.at(u).isRemoved = true;
+        mst.push_back(vertices.at(u));
+
+        for (const Arc &edge : graph.neighbors(u))
+        {
+            if (vertices.at(edge.dest).isRemoved)
+                continue;
+
+            int adjVertex = edge.dest;
+            if (edge.weight < vertices.at(adjVertex).distance)
+            {
+                vertices.at(adjVertex).parent = u;
+                vertices.at(adjVertex).distance = edge.weight;
+                minHeap.decreaseKey(adjVertex, edge.weight);
+            }
+        }
+    }
+
+    return mst;
+}
+
+// Preorder walk of the tree described by the parent links of the MST vertices, rooted at mst[0].
+inline std::vector<int> preorderWalk(int V, const std::vector<VertexInfo> &mst)
+{
+    std::vector<int> preorder;
+    if (mst.empty())
+        return preorder;
+
+    std::vector<std::vector<int>> tree(V);
+    for (const auto &info : mst)
+    {
+        if (info.parent == -1)
+            continue;
+
+        tree[info.parent].push_back(info.vertex);
+    }
+
+    std::vector<bool> visited(V, false);
+    std::stack<int> stack;
+
+    stack.push(mst[0].vertex);
+    while (!stack.empty())
+    {
+        int current = stack.top();
+        stack.pop();
+
+        if (!visited[current])
+        {
+            visited[current] = true;
+            preorder.push_back(current);
+
+            for (auto it = tree[current].rbegin(); it != tree[current].rend(); ++it)
+            {
+                if (!visited[*it])
+                    stack.push(*it);
+            }
+        }
+    }
+
+    return preorder;
+}
+
+template <typename TGraph>
+std::pair<std::pair<std::vector<int>, int>, double> nearestNeighborTSP(const TGraph &graph, int start)
+{
+    int V = graph.verticesCount();
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    std::vector<int> tour;
+    int totalWeight = 0;
+    std::vector<bool> visited(V, false);
+    int current = start;
+    tour.push_back(current);
+    visited[current] = true;
+
+    for (int i = 1; i < V; ++i)
+    {
+        int minWeight = std::numeric_limits<int>::max();
+        int nextEdge;
+        for (const Arc &edge : graph.neighbors(current))
+        {
+            if (!visited[edge.dest] && edge.weight < minWeight)
+            {
+                minWeight = edge.weight;
+                nextEdge = edge.dest;
+            }
+        }
+        tour.push_back(nextEdge);
+        totalWeight += minWeight;
+        visited[nextEdge] = true;
+        current = nextEdge;
+    }
+
+    tour.push_back(start);
+    totalWeight += graph.weight(current, start);
+
+    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start_time;
+    return std::make_pair(std::make_pair(tour, totalWeight), duration.count());
+}
+
+// Nearest neighbour construction on city coordinates: a k-d tree answers the nearest unvisited city query,
+// so the tour is built in about O(n log n) instead of scanning every city at each step.
+std::pair<std::pair<std::vector<int>, int>, double> nearestNeighborTSP(const EuclideanGraph &graph, int start);
+
+template <typename TGraph>
+std::pair<std::pair<std::vector<int>, int>, double> doubleTreeTSP(const TGraph &graph, int start)
+{
+    int V = graph.verticesCount();
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    std::vector<VertexInfo> mst = primMST(graph, start);
+    std::vector<int> preorder = preorderWalk(V, mst);
+
+    preorder.push_back(preorder.front());
+
+    int totalWeight = 0;
+    for (std::size_t i = 0; i + 1 < preorder.size(); ++i)
+    {
+        int u = preorder[i];
+        int v = preorder[i + 1];
+
+        if (graph.hasEdge(u, v))
+            totalWeight += graph.weight(u, v);
+    }
+
+    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start_time;
+    return std::make_pair(std::make_pair(preorder, totalWeight), duration.count());
+}
+
+// Euclidean minimum spanning tree by Borůvka rounds over a k-d tree: each round every city finds its nearest city in
+// another component, and every component joins along its shortest such edge, so O(log n) rounds of O(n log n) queries
+// replace Prim's quadratic scan of the complete graph. Edges are compared exactly on squared distance, which also gives
+// a minimum tree for the rounded weights. The result has the same form as primMST: mst[0] is start and every other
+// vertex carries its parent and the weight of the edge to it.
+std::vector<VertexInfo> euclideanMST(const EuclideanGraph &graph, int start);
+
+// Double tree on city coordinates built on euclideanMST. Every pair of cities is joined, so the tour weight is summed
+// directly without edge lookups.
+std::pair<std::pair<std::vector<int>, int>, double> doubleTreeTSP(const EuclideanGraph &graph, int start);
+
+// Vertices of odd degree in the tree described by the MST parent links, in the order of its preorder walk.
+// Pairing consecutive ones along this order is a matching no heavier than the tree itself.
+inline std::vector<int> oddDegreeVertices(int V, const std::vector<VertexInfo> &mst)
+{
+    std::vector<int> degree(V, 0);
+    for (const auto &info : mst)
+    {
+        if (info.parent == -1)
+            continue;
+
+        ++degree[info.vertex];
+        ++degree[info.parent];
+    }
+
+    std::vector<int> odd;
+    for (int v : preorderWalk(V, mst))
+    {
+        if (degree[v] % 2 == 1)
+            odd.push_back(v);
+    }
+    return odd;
+}
+
+// Euler circuit (Hierholzer) of the MST edges joined with the matching edges, shortcut to its first visit of every
+// vertex. Every vertex has even degree in that multigraph, so the circuit covers all edges. Returns a closed tour from
+// start.
+inline std::vector<int> eulerShortcut(int V, const std::vector<VertexInfo> &mst, const std::vector<std::pair<int, int>> &matching,
+                                      int start)
+{
+    std::vector<std::pair<int, int>> edges;
+    edges.reserve(mst.size() + matching.size());
+    for (const auto &info : mst)
+    {
+        if (info.parent != -1)
+            edges.emplace_back(info.parent, info.vertex);
+    }
+    edges.insert(edges.end(), matching.begin(), matching.end());
+
+    std::vector<int> offsets(V + 1, 0);
+    for (const auto &edge : edges)
+    {
+        ++offsets[edge.first + 1];
+        ++offsets[edge.second + 1];
+    }
+    for (int v = 0; v < V; ++v)
+        offsets[v + 1] += offsets[v];
+
+    std::vector<int> incident(offsets[V]);
+    std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (int e = 0; e < static_cast<int>(edges.size()); ++e)
+    {
+        incident[fill[edges[e].first]++] = e;
+        incident[fill[edges[e].second]++] = e;
+    }
+
+    std::vector<bool> used(edges.size(), false);
+    std::vector<bool> visited(V, false);
+    std::vector<int> tour;
+    tour.reserve(V + 1);
+    std::stack<int> stack;
+    stack.push(start);
+    // Next unexamined incident edge of every vertex, so each edge is looked at twice in total.
+    std::vector<int> ends(offsets.begin() + 1, offsets.end());
+    std::vector<int> &cursor = offsets;
+
+    while (!stack.empty())
+    {
+        int v = stack.top();
+        while (cursor[v] < ends[v] && used[incident[cursor[v]]])
+            ++cursor[v];
+
+        if (cursor[v] == ends[v])
+        {
+            // Vertices leave the stack in circuit order (reversed, which is a circuit as well), starting at start.
+            stack.pop();
+            if (!visited[v])
+            {
+                visited[v] = true;
+                tour.push_back(v);
+            }
+            continue;
+        }
+
+        int e = incident[cursor[v]];
+        used[e] = true;
+        stack.push(edges[e].first == v ? edges[e].second : edges[e].first);
+    }
+
+    tour.push_back(start);
+    return tour;
+}
+
+// Christofides-style construction: the odd-degree vertices of the MST are matched greedily, lightest edge first,
+// and the Euler circuit of tree and matching is shortcut into a tour. Odd vertices with no free odd neighbour left
+// are paired consecutively along the tree's preorder. Tour edges missing from the graph are skipped in the weight,
+// as in doubleTreeTSP.
+template <typename TGraph>
+std::pair<std::pair<std::vector<int>, int>, double> christofidesTSP(const TGraph &graph, int start)
+{
+    int V = graph.verticesCount();
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    std::vector<VertexInfo> mst = primMST(graph, start);
+    std::vector<int> odd = oddDegreeVertices(V, mst);
+    std::vector<bool> isOdd(V, false);
+    for (int v : odd)
+        isOdd[v] = true;
+
+    std::vector<std::tuple<int, int, int>> pairs;
+    for (int u : odd)
+    {
+        for (const Arc &edge : graph.neighbors(u))
+        {
+            if (edge.dest > u && isOdd[edge.dest])
+                pairs.emplace_back(edge.weight, u, edge.dest);
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+
+    std::vector<bool> matched(V, false);
+    std::vector<std::pair<int, int>> matching;
+    for (const auto &pair : pairs)
+    {
+        int u = std::get<1>(pair);
+        int v = std::get<2>(pair);
+        if (matched[u] || matched[v])
+            continue;
+
+        matched[u] = matched[v] = true;
+        matching.emplace_back(u, v);
+    }
+
+    int waiting = -1;
+    for (int v : odd)
+    {
+        if (matched[v])
+            continue;
+
+        if (waiting == -1)
+            waiting = v;
+        else
+        {
+            matching.emplace_back(waiting, v);
+            waiting = -1;
+        }
+    }
+
+    std::vector<int> tour = eulerShortcut(V, mst, matching, start);
+
+    int totalWeight = 0;
+    for (std::size_t i = 0; i + 1 < tour.size(); ++i)
+    {
+        if (graph.hasEdge(tour[i], tour[i + 1]))
+            totalWeight += graph.weight(tour[i], tour[i + 1]);
+    }
+
+    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start_time;
+    return std::make_pair(std::make_pair(tour, totalWeight), duration.count());
+}
+
+// Christofides-style construction on city coordinates in about O(n log n): the tree comes from euclideanMST and the
+// greedy matching runs over the k nearest odd neighbours of every odd city, found with a k-d tree. Cities left
+// unmatched are paired with their nearest unmatched odd city.
+std::pair<std::pair<std::vector<int>, int>, double> christofidesTSP(const EuclideanGraph &graph, int start);
+
+// Space-filling curve construction: cities are visited in the order of the Hilbert curve through their coordinates,
+// rotated to begin at start. Needs only a sort, so it is O(n log n) even for millions of cities, though the tour is
+// about a third longer than the optimum on uniform inputs. cities[v] holds the coordinates of vertex v. Tour edges
+// missing from the graph are skipped in the weight, as in doubleTreeTSP.
+template <typename TGraph>
+std::pair<std::pair<std::vector<int>, int>, double> hilbertCurveTSP(const TGraph &graph, const std::vector<City> &cities, int start)
+{
+    int V = graph.verticesCount();
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    std::vector<int> order = hilbertOrder(cities);
+    std::vector<int> tour;
+    tour.reserve(V + 1);
+    int first = static_cast<int>(std::find(order.begin(), order.end(), start) - order.begin());
+    for (int i = 0; i < V; ++i)
+        tour.push_back(order[(first + i) % V]);
+    tour.push_back(start);
+
+    int totalWeight = 0;
+    for (std::size_t i = 0; i + 1 < tour.size(); ++i)
+    {
+        if (graph.hasEdge(tour[i], tour[i + 1]))
+            totalWeight += graph.weight(tour[i], tour[i + 1]);
+    }
+
+    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start_time;
+    return std::make_pair(std::make_pair(tour, totalWeight), duration.count());
+}
+
+std::pair<std::pair<std::vector<int>, int>, double> hilbertCurveTSP(const EuclideanGraph &graph, int start);
+
+// Random insertion keeps the tour as a cycle of successor and predecessor links, so an insertion is O(1) and the
+// unvisited pool shrinks by swap-remove. Without candidates every tour edge is scanned for the cheapest insertion.
+// With candidate lists (k entries per vertex, as from candidateLists) only the tour edges next to the new vertex's
+// candidates are scanned, falling back to the full scan while none of them is in the tour yet.
+// The insertion order is drawn from an RNG seeded with seed, so equal seeds give equal tours.
+template <typename TGraph>
+std::pair<std::pair<std::vector<int>, int>, double> randomInsertionTSP(const TGraph &graph, int start1, int start2,
+                                                                       const std::vector<int> &candidates = {}, unsigned seed = 0)
+{
+    int V = graph.verticesCount();
+    auto start_time = std::chrono::high_resolution_clock::now();
+    int k = candidates.empty() ? 0 : static_cast<int>(candidates.size() / V);
+
+    // -1 marks vertices that are not in the tour yet.
+    std::vector<int> next(V, -1);
+    std::vector<int> prev(V, -1);
+    next[start1] = prev[start1] = start2;
+    next[start2] = prev[start2] = start1;
+
+    int totalWeight = 2 * graph.weight(start1, start2);
+
+    std::vector<int> unvisited;
+    unvisited.reserve(V);
+    for (auto i = 0; i < V; ++i)
+    {
+        if (i == start1 || i == start2)
+            continue;
+
+        unvisited.push_back(i);
+    }
+
+    std::mt19937 rng(seed);
+    while (!unvisited.empty())
+    {
+        int randIndex = std::uniform_int_distribution<int>(0, static_cast<int>(unvisited.size()) - 1)(rng);
+        int newVertex = unvisited[randIndex];
+        unvisited[randIndex] = unvisited.back();
+        unvisited.pop_back();
+
+        int bestDiff = std::numeric_limits<int>::max();
+        int insertAfter = -1;
+        auto tryEdge = [&](int u)
+        {
+            int v = next[u];
+            int diff = graph.weight(u, newVertex) + graph.weight(newVertex, v) - graph.weight(u, v);
+            if (diff < bestDiff)
+            {
+                bestDiff = diff;
+                insertAfter = u;
+            }
+        };
+
+        for (int i = 0; i < k; ++i)
+        {
+            int candidate = candidates[static_cast<std::size_t>(newVertex) * k + i];
+            if (candidate == -1)
+                break;
+            if (next[candidate] == -1)
+                continue;
+
+            tryEdge(candidate);
+            tryEdge(prev[candidate]);
+        }
+
+        if (insertAfter == -1)
+        {
+            int u = start1;
+            do
+            {
+                tryEdge(u);
+                u = next[u];
+            } while (u != start1);
+        }
+
+        int v = next[insertAfter];
+        next[insertAfter] = newVertex;
+        prev[newVertex] = insertAfter;
+        next[newVertex] = v;
+        prev[v] = newVertex;
+        totalWeight += bestDiff;
+    }
+
+    std::vector<int> tour;
+    tour.reserve(V + 1);
+    int current = start1;
+    for (int i = 0; i < V; ++i)
+    {
+        tour.push_back(current);
+        current = next[current];
+    }
+    tour.push_back(start1);
+
+    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start_time;
+    return std::make_pair(std::make_pair(tour, totalWeight), duration.count());
+}
+
+// Full-scan random insertion on city coordinates with the insertion cost reduction spread over the pool. Tour edges
+// are kept unordered in structure-of-arrays form (an insertion rewrites one slot and appends one), so the cost of every
+// tour edge is computed by a flat, vectorizable loop and each worker reduces its own chunk. Ties go to the lowest slot,
+// which keeps the tour independent of the number of threads and equal for equal seeds.
+std::pair<std::pair<std::vector<int>, int>, double> randomInsertionTSP(const EuclideanGraph &graph, int start1, int start2,
+                                                                       ThreadPool &pool, unsigned seed = 0);
+
+#endif // TSP_HEURISTICS_H
@@ -0,0 +1,93 @@
+#ifndef TSP_PORTFOLIO_H
+#define TSP_PORTFOLIO_H
+
+#include <vector>
+#include <random>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+#include "TspHeuristics.h"
+#include "TourImprovement.h"
+#include "ThreadPool.h"
+
+// Construction heuristics available to portfolioTSP.
+enum class TspHeuristic
+{
+    NearestNeighbor,
+    DoubleTree,
+    Christofides,
+    RandomInsertion
+};
+
+// Builds runs tours on the pool and returns the shortest one. Run r uses heuristics[r % heuristics.size()] and draws its
+// start vertices and insertion order from an RNG seeded with (seed, r), so the result depends on the seed but not on
+// the number of threads. With candidate lists every tour is also improved with Or-3opt, and random insertion scans
+// only edges next to candidates. Ties between equally long tours go to the lowest run index.
+template <typename TGraph>
+std::pair<std::pair<std::vector<int>, int>, double> portfolioTSP(const TGraph &graph, int runs, const std::vector<TspHeuristic> &heuristics,
+                                                                 ThreadPool &pool, const std::vector<int> &candidates = {}, unsigned seed = 0)
+{
+    int V = graph.verticesCount();
+    if (runs <= 0 || heuristics.empty())
+        throw std::invalid_argument("The portfolio needs at least one run and one heuristic.");
+    if (V < 2)
+        throw std::invalid_argument("The graph must have at least two vertices.");
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    // Best (weight, run) and its tour for every worker.
+    std::vector<std::pair<int, int>> workerBest(pool.size(), std::make_pair(std::numeric_limits<int>::max(), runs));
+    std::vector<std::vector<int>> workerTours(pool.size());
+
+    pool.parallelFor(runs, 1, [&](int worker, int begin, int end)
+                     {
+        for (int run = begin; run < end; ++run)
+        {
+            std::seed_seq sequence{seed, static_cast<unsigned>(run)};
+            std::mt19937 rng(sequence);
+            std::uniform_int_distribution<int> vertex(0, V - 1);
+            int start = vertex(rng);
+
+            std::pair<std::pair<std::vector<int>, int>, double> result;
+            switch (heuristics[run % heuristics.size()])
+            {
+            case TspHeuristic::NearestNeighbor:
+                result = nearestNeighborTSP(graph, start);
+                break;
+            case TspHeuristic::DoubleTree:
+                result = doubleTreeTSP(graph, start);
+                break;
+            case TspHeuristic::Christofides:
+                result = christofidesTSP(graph, start);
+                break;
+            case TspHeuristic::RandomInsertion:
+            {
+                int second = std::uniform_int_distribution<int>(0, V - 2)(rng);
+                result = randomInsertionTSP(graph, start, second >= start ? second + 1 : second, candidates, rng());
+                break;
+            }
+            }
+
+            if (!candidates.empty())
+                result = orThreeOptTSP(graph, result.first.first, candidates);
+
+            std::pair<int, int> score(result.first.second, run);
+            if (score < workerBest[worker])
+            {
+                workerBest[worker] = score;
+                workerTours[worker] = std::move(result.first.first);
+            }
+        } });
+
+    int bestWorker = 0;
+    for (int worker = 1; worker < pool.size(); ++worker)
+    {
+        if (workerBest[worker] < workerBest[bestWorker])
+            bestWorker = worker;
+    }
+
+    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start_time;
+    return std::make_pair(std::make_pair(workerTours[bestWorker], workerBest[bestWorker].first), duration.count());
+}
+
+#endif // TSP_PORTFOLIO_H
@@ -0,0 +1,107 @@
+#ifndef UNION_FIND_H
+#define UNION_FIND_H
+
+#include <vector>
+#include <utility>
+#include <atomic>
+
+// UnionFind (disjoint-set forest) over the integers [0, n) with union by size and path halving,
+// so every operation runs in near-constant amortized time.
+class UnionFind
+{
+public:
+    explicit UnionFind(int n) : parent(n), sizes(n, 1), sets(n)
+    {
+        for (int i = 0; i < n; ++i)
+            parent[i] = i;
+    }
+
+    int find(int x)
+    {
+        while (parent[x] != x)
+        {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+
+    // Merges the sets of a and b. Returns false if they already were one set.
+    bool unite(int a, int b)
+    {
+        a = find(a);
+        b = find(b);
+        if (a == b)
+            return false;
+
+        if (sizes[a] < sizes[b])
+            std::swap(a, b);
+        parent[b] = a;
+        sizes[a] += sizes[b];
+        --sets;
+        return true;
+    }
+
+    bool connected(int a, int b) { return find(a) == find(b); }
+    int setsCount() const { return sets; }
+
+private:
+    std::vector<int> parent;
+    std::vector<int> sizes;
+    int sets;
+};
+
+// ConcurrentUnionFind is a lock-free disjoint-set forest whose find and unite may run from many threads at once.
+// Roots are linked by compare-and-swap, always the higher index below the lower one, so concurrent links cannot form a
+// cycle; find halves paths with compare-and-swap as well. The representative of a set is its smallest linked root,
+// which is stable once no unite runs.
+class ConcurrentUnionFind
+{
+public:
+    explicit ConcurrentUnionFind(int n) : parent(n)
+    {
+        for (int i = 0; i < n; ++i)
+            parent[i].store(i, std::memory_order_relaxed);
+    }
+
+    int find(int x)
+    {
+        while (true)
+        {
+            int p = parent[x].load(std::memory_order_relaxed);
+            if (p == x)
+                return x;
+
+            int grandparent = parent[p].load(std::memory_order_relaxed);
+            if (p != grandparent)
+                parent[x].compare_exchange_weak(p, grandparent, std::memory_order_relaxed);
+            x = grandparent;
+        }
+    }
+
+    // Merges the sets of a and b. Returns false if they already were one set; when several threads merge the same
+    // two sets, exactly one of them gets true.
+    bool unite(int a, int b)
+    {
+        while (true)
+        {
+            a = find(a);
+            b = find(b);
+            if (a == b)
+                return false;
+
+            if (a > b)
+                std::swap(a, b);
+            int expected = b;
+            if (parent[b].compare_exchange_strong(expected, a, std::memory_order_relaxed))
+                return true;
+        }
+    }
+
+    bool connected(int a, int b) { return find(a) == find(b); }
+
+private:
+    std::vector<std::atomic<int>> parent;
+};
+
+#endif // UNION_FIND_H